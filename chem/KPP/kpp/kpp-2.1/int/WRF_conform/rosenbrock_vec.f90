@@ -0,0 +1,313 @@
+
+!~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+SUBROUTINE  KPP_ROOT_INTEGRATE_VEC( NVC, TIN, TOUT, &
+  FIX, VAR, RCONST, ATOL, RTOL,                     &
+  ICNTRL_U, RCNTRL_U, ISTATUS_U, IERR_U  )
+!~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+!
+!    Cell-vector version of KPP_ROOT_INTEGRATE (generated with #CELLVECTOR ON).
+!
+!    Integrates NVC independent copies of the chemical system at once,
+!    VAR(NVC,NVAR), FIX(NVC,NFIX), RCONST(NVC,NREACT), with the Rosenbrock
+!    method selected by ICNTRL_U(3), using the same coefficients as
+!    KPP_ROOT_Rosenbrock.  Function, Jacobian, LU and substitution are the
+!    cell-vector kernels KPP_ROOT_*_Vec, so every operation is a
+!    unit-stride loop over the cells of the block.
+!
+!    Each cell keeps its own time, step size and accept/reject history.
+!    Cells that reached TOUT (or failed) are masked: they are still
+!    carried through the kernels but their state is no longer updated.
+!
+!    Only forward (TOUT > TIN) integration is supported and the reaction
+!    rates IRR are not accumulated; use KPP_ROOT_INTEGRATE when these are
+!    needed.
+!
+!    ICNTRL_U(1:4) and RCNTRL_U(1:7) have the same meaning as for
+!    KPP_ROOT_Rosenbrock.  An ICNTRL_U(3) outside 0..5 returns IERR = -2
+!    in every cell.  ISTATUS_U holds the statistics summed over the block,
+!    IERR_U(NVC) the per-cell exit status.
+!~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+   USE KPP_ROOT_Parameters
+   IMPLICIT NONE
+
+   INTEGER,  INTENT(IN) :: NVC
+   KPP_REAL, INTENT(IN) :: TIN  ! Start Time
+   KPP_REAL, INTENT(IN) :: TOUT ! End Time
+   KPP_REAL, INTENT(IN),    DIMENSION(NVC,NFIX)   :: FIX
+   KPP_REAL, INTENT(INOUT), DIMENSION(NVC,NVAR)   :: VAR
+   KPP_REAL, INTENT(IN),    DIMENSION(NVC,NREACT) :: RCONST
+   KPP_REAL, INTENT(IN),    DIMENSION(NSPEC)      :: ATOL, RTOL
+   INTEGER,  INTENT(IN),  OPTIONAL :: ICNTRL_U(20)
+   KPP_REAL, INTENT(IN),  OPTIONAL :: RCNTRL_U(20)
+   INTEGER,  INTENT(OUT), OPTIONAL :: ISTATUS_U(20)
+   INTEGER,  INTENT(OUT), OPTIONAL :: IERR_U(NVC)
+
+!~~~>  The method parameters, filled in by KPP_ROOT_Ros2 ... KPP_ROOT_Rodas4
+   INTEGER, PARAMETER :: Smax = 6
+   INTEGER  :: Method, ros_S
+   KPP_REAL, DIMENSION(Smax) :: ros_M, ros_E, ros_Alpha, ros_Gamma
+   KPP_REAL, DIMENSION(Smax*(Smax-1)/2) :: ros_A, ros_C
+   KPP_REAL :: ros_ELO
+   LOGICAL, DIMENSION(Smax) :: ros_NewF
+   CHARACTER(LEN=12) :: ros_Name
+
+   KPP_REAL, PARAMETER :: ZERO = 0.0_dp, ONE = 1.0_dp, HALF = 0.5_dp
+   KPP_REAL, PARAMETER :: DeltaMin = 1.0E-5_dp, DeltaMinT = 1.0E-6_dp
+
+!~~~>  Local variables
+   KPP_REAL :: Ynew(NVC,NVAR), Fcn0(NVC,NVAR), Fcn(NVC,NVAR)
+   KPP_REAL :: K(NVC,NVAR,Smax), Yerr(NVC,NVAR), dFdT(NVC,NVAR)
+   KPP_REAL :: Jac0(NVC,LU_NONZERO), Ghimj(NVC,LU_NONZERO)
+   KPP_REAL :: T(NVC), H(NVC), Hstp(NVC), Hnew(NVC), Err(NVC)
+   KPP_REAL :: ghinv(NVC), Scale(NVC), Ymax(NVC), Delta(NVC)
+   INTEGER  :: Nstp(NVC), Nsng(NVC), Nok(NVC), IERR(NVC)
+   LOGICAL  :: Active(NVC), Singular(NVC), Accept(NVC)
+   LOGICAL  :: RejectLastH(NVC), RejectMoreH(NVC)
+   KPP_REAL :: Roundoff, Hmin, Hmax, Hstart, FacMin, FacMax, FacRej, FacSafe
+   KPP_REAL :: HC, AbsTolS, RelTolS
+   INTEGER  :: ICNTRL(20), Max_no_steps, i, j, istage
+   INTEGER  :: Nfun, Njac, Nacc, Nrej, Ndec, Nsol, NstpT
+   LOGICAL  :: Autonomous, VectorTol
+   KPP_REAL :: RCNTRL(20)
+
+   ICNTRL(:) = 0
+   RCNTRL(:) = ZERO
+   IF (PRESENT(ICNTRL_U)) THEN
+     WHERE(ICNTRL_U(:) > 0) ICNTRL(:) = ICNTRL_U(:)
+   END IF
+   IF (PRESENT(RCNTRL_U)) THEN
+     WHERE(RCNTRL_U(:) > 0) RCNTRL(:) = RCNTRL_U(:)
+   END IF
+
+   Autonomous = .NOT.( ICNTRL(1) == 0 )
+   VectorTol  = ( ICNTRL(2) == 0 )
+
+!~~~>  The particular Rosenbrock method chosen, as in KPP_ROOT_Rosenbrock
+   IF (ICNTRL(3) == 0) THEN
+      Method = 4
+   ELSEIF ( (ICNTRL(3) >= 1).AND.(ICNTRL(3) <= 5) ) THEN
+      Method = ICNTRL(3)
+   ELSE
+      PRINT * , 'User-selected Rosenbrock method: ICNTRL(3)=', ICNTRL(3)
+      PRINT * , IERR_NAMES(-2)
+      IF (PRESENT(ISTATUS_U)) ISTATUS_U(:) = 0
+      IF (PRESENT(IERR_U)) IERR_U(:) = -2
+      RETURN
+   END IF
+   SELECT CASE (Method)
+     CASE (1)
+       CALL KPP_ROOT_Ros2(ros_S, ros_A, ros_C, ros_M, ros_E,   &
+          ros_Alpha, ros_Gamma, ros_NewF, ros_ELO, ros_Name)
+     CASE (2)
+       CALL KPP_ROOT_Ros3(ros_S, ros_A, ros_C, ros_M, ros_E,   &
+          ros_Alpha, ros_Gamma, ros_NewF, ros_ELO, ros_Name)
+     CASE (3)
+       CALL KPP_ROOT_Ros4(ros_S, ros_A, ros_C, ros_M, ros_E,   &
+          ros_Alpha, ros_Gamma, ros_NewF, ros_ELO, ros_Name)
+     CASE (4)
+       CALL KPP_ROOT_Rodas3(ros_S, ros_A, ros_C, ros_M, ros_E, &
+          ros_Alpha, ros_Gamma, ros_NewF, ros_ELO, ros_Name)
+     CASE (5)
+       CALL KPP_ROOT_Rodas4(ros_S, ros_A, ros_C, ros_M, ros_E, &
+          ros_Alpha, ros_Gamma, ros_NewF, ros_ELO, ros_Name)
+   END SELECT
+
+   Max_no_steps = 100000
+   IF (ICNTRL(4) > 0) Max_no_steps = ICNTRL(4)
+
+   Roundoff = KPP_ROOT_WLAMCH('E')
+   Hmin    = RCNTRL(1)
+   Hmax    = ABS(TOUT-TIN)
+   IF (RCNTRL(2) > ZERO) Hmax = MIN(ABS(RCNTRL(2)),ABS(TOUT-TIN))
+   Hstart  = MAX(Hmin,DeltaMin)
+   IF (RCNTRL(3) > ZERO) Hstart = MIN(ABS(RCNTRL(3)),ABS(TOUT-TIN))
+   FacMin  = 0.2_dp
+   IF (RCNTRL(4) > ZERO) FacMin = RCNTRL(4)
+   FacMax  = 6.0_dp
+   IF (RCNTRL(5) > ZERO) FacMax = RCNTRL(5)
+   FacRej  = 0.1_dp
+   IF (RCNTRL(6) > ZERO) FacRej = RCNTRL(6)
+   FacSafe = 0.9_dp
+   IF (RCNTRL(7) > ZERO) FacSafe = RCNTRL(7)
+
+   Nfun = 0; Njac = 0; Nacc = 0; Nrej = 0; Ndec = 0; Nsol = 0
+
+   T(:) = TIN
+   H(:) = MIN(Hstart,Hmax)
+   WHERE (ABS(H) <= 10.0_dp*Roundoff) H = DeltaMin
+   Nstp(:) = 0
+   Nsng(:) = 0
+   Nok(:)  = 0
+   IERR(:) = 1
+   RejectLastH(:) = .FALSE.
+   RejectMoreH(:) = .FALSE.
+   Active(:) = ( (T-TOUT)+Roundoff <= ZERO )
+
+TimeLoop: DO WHILE ( ANY(Active) )
+
+!~~~>  Per-cell exit conditions
+   WHERE ( Active .AND. (Nstp > Max_no_steps) )
+      IERR = -6
+      Active = .FALSE.
+   END WHERE
+   WHERE ( Active .AND. ( ((T+0.1_dp*H) == T) .OR. (H <= Roundoff) ) )
+      IERR = -7
+      Active = .FALSE.
+   END WHERE
+   IF ( .NOT. ANY(Active) ) EXIT TimeLoop
+
+!~~~>  Limit H to avoid going beyond TOUT; masked cells keep a harmless H
+   Hstp = H
+   WHERE (Active) Hstp = MIN(H,ABS(TOUT-T))
+
+!~~~>  Function and Jacobian at the current state of every cell
+   CALL KPP_ROOT_Fun_Vec( NVC, VAR, FIX, RCONST, Fcn0 )
+   CALL KPP_ROOT_Jac_SP_Vec( NVC, VAR, FIX, RCONST, Jac0 )
+   Nfun = Nfun+1
+   Njac = Njac+1
+
+!~~~>  Time derivative by finite differences, as KPP_ROOT_ros_FunTimeDeriv
+   IF (.NOT.Autonomous) THEN
+      Delta = SQRT(Roundoff)*MAX(DeltaMinT,ABS(T))
+      CALL KPP_ROOT_Fun_Vec( NVC, VAR, FIX, RCONST, dFdT )
+      Nfun = Nfun+1
+      DO i = 1, NVAR
+         dFdT(:,i) = (ONE/Delta)*(dFdT(:,i) - Fcn0(:,i))
+      END DO
+   END IF
+
+!~~~>  Ghimj = 1/(H*gam) - Jac0 and its LU decomposition
+   ghinv = ONE/(Hstp*ros_Gamma(1))
+   DO j = 1, LU_NONZERO
+      Ghimj(:,j) = -Jac0(:,j)
+   END DO
+   DO i = 1, NVAR
+      Ghimj(:,LU_DIAG(i)) = Ghimj(:,LU_DIAG(i)) + ghinv
+   END DO
+   CALL KPP_ROOT_KppDecomp_Vec( NVC, Ghimj )
+   Ndec = Ndec+1
+
+!~~~>  Cells with a vanishing pivot halve their step and retry
+   Singular(:) = .FALSE.
+   DO i = 1, NVAR
+      Singular = Singular .OR. ( ABS(Ghimj(:,LU_DIAG(i))) < TINY(ONE) )
+   END DO
+   Singular = Singular .AND. Active
+   WHERE (Singular)
+      Nsng = Nsng+1
+      H = H*HALF
+   END WHERE
+   WHERE (Singular .AND. (Nsng > 5))
+      IERR = -8
+      Active = .FALSE.
+   END WHERE
+   WHERE (.NOT. Active) Singular = .TRUE.
+   IF ( .NOT. ANY(Active .AND. .NOT.Singular) ) CYCLE TimeLoop
+   WHERE (.NOT. Singular) Nsng = 0
+   DO i = 1, NVAR
+      WHERE (Singular) Ghimj(:,LU_DIAG(i)) = ONE
+   END DO
+
+!~~~>  Compute the stages; zero coefficients are skipped as KPP_ROOT_WAXPY does
+Stage: DO istage = 1, ros_S
+      IF ( istage == 1 ) THEN
+         Fcn = Fcn0
+      ELSEIF ( ros_NewF(istage) ) THEN
+         Ynew = VAR
+         DO j = 1, istage-1
+            HC = ros_A((istage-1)*(istage-2)/2+j)
+            IF (HC /= ZERO) Ynew = Ynew + HC*K(:,:,j)
+         END DO
+         CALL KPP_ROOT_Fun_Vec( NVC, Ynew, FIX, RCONST, Fcn )
+         Nfun = Nfun+1
+      END IF
+      K(:,:,istage) = Fcn
+      DO j = 1, istage-1
+         HC = ros_C((istage-1)*(istage-2)/2+j)
+         DO i = 1, NVAR
+            K(:,i,istage) = K(:,i,istage) + HC/Hstp*K(:,i,j)
+         END DO
+      END DO
+      IF ((.NOT.Autonomous).AND.(ros_Gamma(istage) /= ZERO)) THEN
+         DO i = 1, NVAR
+            K(:,i,istage) = K(:,i,istage) + Hstp*ros_Gamma(istage)*dFdT(:,i)
+         END DO
+      END IF
+      CALL KPP_ROOT_KppSolve_Vec( NVC, Ghimj, K(:,:,istage) )
+      Nsol = Nsol+1
+   END DO Stage
+
+!~~~>  New solution and error estimate
+   Ynew = VAR
+   Yerr = ZERO
+   DO j = 1, ros_S
+      IF (ros_M(j) /= ZERO) Ynew = Ynew + ros_M(j)*K(:,:,j)
+      IF (ros_E(j) /= ZERO) Yerr = Yerr + ros_E(j)*K(:,:,j)
+   END DO
+
+   Err = ZERO
+   AbsTolS = ATOL(1)
+   RelTolS = RTOL(1)
+   DO i = 1, NVAR
+      IF (VectorTol) THEN
+         AbsTolS = ATOL(i)
+         RelTolS = RTOL(i)
+      END IF
+      Ymax  = MAX(ABS(VAR(:,i)),ABS(Ynew(:,i)))
+      Scale = AbsTolS+RelTolS*Ymax
+      Err   = Err+(Yerr(:,i)/Scale)**2
+   END DO
+   Err = SQRT(Err/NVAR)
+
+!~~~>  New step size is bounded by FacMin <= Hnew/H <= FacMax
+   Hnew = Hstp*MIN(FacMax,MAX(FacMin,FacSafe/MAX(Err,TINY(ONE))**(ONE/ros_ELO)))
+
+!~~~>  Accept or reject, independently in every unmasked cell
+   Accept = ( Active .AND. .NOT.Singular ) .AND. ( (Err <= ONE) .OR. (Hstp <= Hmin) )
+   WHERE ( Active .AND. .NOT.Singular ) Nstp = Nstp+1
+   DO i = 1, NVAR
+      WHERE (Accept) VAR(:,i) = Ynew(:,i)
+   END DO
+   WHERE (Accept)
+      T = T + Hstp
+      Hnew = MAX(Hmin,MIN(Hnew,Hmax))
+   END WHERE
+   WHERE (Accept .AND. RejectLastH) Hnew = MIN(Hnew,Hstp)
+   WHERE (Accept)
+      RejectLastH = .FALSE.
+      RejectMoreH = .FALSE.
+      H = Hnew
+   END WHERE
+   WHERE ( Active .AND. .NOT.Singular .AND. .NOT.Accept )
+      Hnew = MERGE(Hstp*FacRej, Hnew, RejectMoreH)
+      RejectMoreH = RejectLastH
+      RejectLastH = .TRUE.
+      H = Hnew
+   END WHERE
+   Nacc = Nacc + COUNT(Accept)
+   WHERE (Accept) Nok = Nok+1
+   ! like the scalar code, rejections before a cell's first accepted step
+   ! are not counted
+   Nrej = Nrej + COUNT(Active .AND. .NOT.Singular .AND. .NOT.Accept .AND. Nok >= 1)
+
+   WHERE (Active) Active = ( (T-TOUT)+Roundoff <= ZERO )
+
+   END DO TimeLoop
+
+   IF (PRESENT(ISTATUS_U)) THEN
+      NstpT = SUM(Nstp)
+      ISTATUS_U(:) = 0
+      ISTATUS_U(ifun) = Nfun
+      ISTATUS_U(ijac) = Njac
+      ISTATUS_U(istp) = NstpT
+      ISTATUS_U(iacc) = Nacc
+      ISTATUS_U(irej) = Nrej
+      ISTATUS_U(idec) = Ndec
+      ISTATUS_U(isol) = Nsol
+      ISTATUS_U(isng) = COUNT(IERR == -8)
+   END IF
+   IF (PRESENT(IERR_U)) IERR_U(:) = IERR(:)
+
+END SUBROUTINE  KPP_ROOT_INTEGRATE_VEC
+
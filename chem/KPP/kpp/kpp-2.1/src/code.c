@@ -103,6 +103,11 @@ FILE * currentFile;
 
 int ident = 0;
 
+/* varTable index of the NVC (cells per block) variable while cell-vector
+   kernels are written, 0 for scalar code; real vectors then carry a leading
+   cell index of extent NVC */
+int cellDim = 0;
+
 FILE * UseFile( FILE * file )
 {
 FILE *oldf;
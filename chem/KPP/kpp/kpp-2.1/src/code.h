@@ -82,6 +82,7 @@ extern FILE * currentFile;
 
 extern int ident;
 extern int real;
+extern int cellDim;
 extern char * CommonName;
 
 void OpenFile( FILE **fpp, char *name, char * ext, char * identity );
@@ -45,6 +45,14 @@ char *F90_types[] = { "",                   /* VOID */
                     "CHARACTER(LEN=100)"  /* DOUBLESTRING */
                   };
 
+/*************************************************************************************************/
+/* In cell-vector kernels every real vector is blocked over cells */
+int F90_IsCellVar( VARIABLE * var )
+{
+  return ( var->type == VELM ) && 
+         ( ( var->baseType == REAL ) || ( var->baseType == DOUBLE ) );
+}
+
 /*************************************************************************************************/
 void F90_WriteElm( NODE * n )
 {
@@ -63,7 +71,10 @@ char maxj[20];
 		break;
     case VELM:  if( elm->val.idx.i >= 0 ) sprintf( maxi, "%d", elm->val.idx.i+1 );
                   else sprintf( maxi, "%s", varTable[ -elm->val.idx.i ]->name );
-                bprintf("%s(%s)", name, maxi ); 
+                if( cellDim && F90_IsCellVar( varTable[ elm->var ] ) )
+                  bprintf("%s(:,%s)", name, maxi ); 
+                else
+                  bprintf("%s(%s)", name, maxi ); 
 		break;
     case MELM:  if( elm->val.idx.i >= 0 ) sprintf( maxi, "%d", elm->val.idx.i+1 );
                   else sprintf( maxi, "%s", varTable[ -elm->val.idx.i ]->name );
@@ -136,7 +147,8 @@ char op_mult=0xaa, op_plus=0xab, op_minus=0xad, op_dot=0xae, op_div=0xaf;
           Note: the approach below will create erroneous code if the +/- is within a subexpression, e.g. for
           A*(B+C) one cannot start a new continuation line by splitting at the + sign */
      for( j=linelg; j>5; j-- ) /* split row here if +, -, or comma */
-       if ( ( rs[j] == op_plus )||( rs[j] == op_minus )||( rs[j]==',' ) ) { 
+       /* cell-vector kernels carry commas inside subscripts, V(:,i) */
+       if ( ( rs[j] == op_plus )||( rs[j] == op_minus )||( (rs[j]==',')&&(!cellDim) ) ) { 
         jfound = 1; i=j; break;
 	}
     }
@@ -234,7 +246,11 @@ char maxj[20];
 		      sprintf( maxi, "%d", (varTable[-var->maxi]->value)==0?
 		           1:varTable[-var->maxi]->value );
 		}  
-                sprintf( buf, "%s :: %s(%s)", baseType, var->name, maxi );
+                if( cellDim && F90_IsCellVar( var ) )
+                  sprintf( buf, "%s :: %s(%s,%s)", baseType, var->name, 
+                           varTable[ cellDim ]->name, maxi );
+                else
+                  sprintf( buf, "%s :: %s(%s)", baseType, var->name, maxi );
  		break;
     case MELM:  
                 if( var->maxi > 0 ) sprintf( maxi, "%d", var->maxi );
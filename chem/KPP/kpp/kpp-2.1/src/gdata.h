@@ -148,6 +148,7 @@ extern int useEqntags;
 extern int useLang;
 extern int useStochastic;
 extern int useWRFConform; 
+extern int useCellVector;
 
 extern char Home[ MAX_PATH ];
 extern char integrator[ MAX_PATH ];
@@ -186,6 +187,7 @@ void CmdJacobian( char *cmd );
 void CmdHessian( char *cmd );
 void CmdDouble( char *cmd );
 void CmdReorder( char *cmd );
+void CmdCellVector( char *cmd );
 void CmdMex( char *cmd );
 void CmdDummyindex( char *cmd );
 void CmdEqntags( char *cmd );
@@ -1896,17 +1896,45 @@ void GenerateDJacDRcoeff()
 
 
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+void WriteSolveBody( int *icol, int *crow, int *diag )
+{
+int i, j;
+int ibgn, iend;
+
+  for( i = 0; i < VarNr; i++) {
+    ibgn = crow[i];
+    iend = diag[i];
+    if( ibgn <= iend ) {
+      sum = Elm( X, i );
+      if ( ibgn < iend ) { 
+        for( j = ibgn; j < iend; j++ )
+          sum = Sub( sum, Mul( Elm( JVS, j ), Elm( X, icol[j] ) ) );
+        Assign( Elm( X, i ), sum );
+      }
+    }
+  }
+
+  for( i = VarNr-1; i >=0; i--) {
+    ibgn = diag[i] + 1;
+    iend = crow[i+1]; 
+    sum = Elm( X, i );
+    for( j = ibgn; j < iend; j++ )
+      sum = Sub( sum, Mul( Elm( JVS, j ), Elm( X, icol[j] ) ) );
+    sum = Div( sum, Elm( JVS, diag[i] ) );
+    Assign( Elm( X, i ), sum );
+  }
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 void GenerateSolve()
 {
-int i, j;
 int SOLVE;
 int *irow;
 int *icol;
 int *crow;
 int *diag;
 int nElm;
-int ibgn, iend;
 int useLangOld;
 int dim;
 char buf1[100];
@@ -1938,28 +1966,7 @@ char buf1[100];
   SOLVE = DefFnc( buf1, 2, "sparse back substitution");
   FunctionBegin( SOLVE, JVS, X );
 
-  for( i = 0; i < VarNr; i++) {
-    ibgn = crow[i];
-    iend = diag[i];
-    if( ibgn <= iend ) {
-      sum = Elm( X, i );
-      if ( ibgn < iend ) { 
-        for( j = ibgn; j < iend; j++ )
-          sum = Sub( sum, Mul( Elm( JVS, j ), Elm( X, icol[j] ) ) );
-        Assign( Elm( X, i ), sum );
-      }
-    }
-  }
-
-  for( i = VarNr-1; i >=0; i--) {
-    ibgn = diag[i] + 1;
-    iend = crow[i+1]; 
-    sum = Elm( X, i );
-    for( j = ibgn; j < iend; j++ )
-      sum = Sub( sum, Mul( Elm( JVS, j ), Elm( X, icol[j] ) ) );
-    sum = Div( sum, Elm( JVS, diag[i] ) );
-    Assign( Elm( X, i ), sum );
-  }
+  WriteSolveBody( icol, crow, diag );
 
   FunctionEnd( SOLVE );
   FreeVariable( SOLVE );
@@ -2059,6 +2066,264 @@ int dim;
 }
 
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*  Cell-vector kernels (#CELLVECTOR ON, WRF conform F90 only):                                  */
+/*  the same sparse code as the scalar routines, but every species, rate and Jacobian entry is    */
+/*  an array over a block of NVC grid cells, V(NVC,NVAR), so each statement is a SIMD loop.       */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+int NVC;
+
+void GenerateFunVec()
+{
+int i, j, k;
+int used;
+int F_VEC;
+char buf1[100];
+
+  if( VarNr == 0 ) return;
+
+  UseFile( integratorFile );
+
+  sprintf( buf1, "%s_Fun_Vec", rootFileName ); 
+  F_VEC = DefFnc( buf1, 5, "time derivatives of variables - cell-vector form");
+
+  cellDim = NVC;
+  FunctionBegin( F_VEC, NVC, V, F, RCT, Vdot );
+
+  NewLines(1);
+  WriteComment("Local variables");
+  Declare( A );
+
+  NewLines(1);
+  WriteComment("Computation of equation rates");
+  
+  for(j=0; j<EqnNr; j++) {
+    used = 0;
+    for (i = 0; i < VarNr; i++) 
+      if ( Stoich[i][j] != 0 ) { 
+        used = 1;
+        break;
+      }
+    if ( used ) {    
+      prod = RConst( j );
+      for (i = 0; i < VarNr; i++) 
+        for (k = 1; k <= (int)Stoich_Left[i][j]; k++ )
+          prod = Mul( prod, Elm( V, i ) ); 
+      for ( ; i < SpcNr; i++) 
+        for (k = 1; k <= (int)Stoich_Left[i][j]; k++ )
+          prod = Mul( prod, Elm( F, i - VarNr ) );
+      Assign( Elm( A, j ), prod );
+    }
+  }
+
+  NewLines(1);
+  WriteComment("Aggregate function");
+
+  for (i = 0; i < VarNr; i++) {
+    sum = Const(0);
+    for (j = 0; j < EqnNr; j++) 
+      sum = Add( sum, Mul( Const( Stoich[i][j] ), Elm( A, j ) ) );
+    Assign( Elm( Vdot, i ), sum );
+  }    
+
+  FunctionEnd( F_VEC );
+  cellDim = 0;
+  FreeVariable( F_VEC );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+void GenerateJacVec()
+{
+int i,j,k,l,m;
+int nElm, nonzeros_B;
+int JAC_VEC;
+char buf1[100];
+  
+  if( VarNr == 0 ) return;
+
+  UseFile( integratorFile );
+
+  sprintf( buf1, "%s_Jac_SP_Vec", rootFileName );  
+  JAC_VEC = DefFnc( buf1, 5, "the Jacobian of Variables in sparse matrix representation - cell-vector form");
+
+  cellDim = NVC;
+  FunctionBegin( JAC_VEC, NVC, V, F, RCT, JVS );
+
+  /* Same B numbering as GenerateJac */
+  nonzeros_B = 0;
+  for ( i=0; i<EqnNr; i++ ) 
+    for ( j=0; j<SpcNr; j++ ) 
+       if ( structB[i][j] != 0 ) {
+	 nonzeros_B++;
+         structB[i][j] = nonzeros_B;
+	 }
+
+  NewLines(1);
+  WriteComment("Local variables");
+  varTable[ NTMPB ] -> value = nonzeros_B;
+  Declare( BV );
+  NewLines(1);
+
+  for ( i=0; i<EqnNr; i++ ) {
+    for ( j=0; j<VarNr; j++ ) {
+      if ( Stoich_Left[j][i] != 0 ) {
+        prod = Mul( RConst( i ), Const( Stoich_Left[j][i] ) );
+        for (l = 0; l < VarNr; l++) { 
+          m = (int)Stoich_Left[l][i] - (l==j);
+          for (k = 1; k <= m; k++ )
+            prod = Mul( prod, Elm( V, l ) ); 
+        }      
+        for ( ; l < SpcNr; l++) 
+          for (k = 1; k <= (int)Stoich_Left[l][i]; k++ )
+            prod = Mul( prod, Elm( F, l - VarNr ) );
+        Assign( Elm( BV, structB[i][j]-1 ), prod );
+      }
+    }
+  }
+
+  nElm = 0;
+  NewLines(1);
+  WriteComment("Construct the Jacobian terms from B's"); 
+
+  for (i = 0; i < VarNr; i++) {
+    for (j = 0; j < VarNr; j++) {
+      if( LUstructJ[i][j] ) {
+        sum = Const(0);
+        for (k = 0; k < EqnNr; k++) {
+          if( Stoich[i][k]*structB[k][j] != 0 ) 
+            sum = Add( sum, Mul( Const( Stoich[i][k] ), Elm( BV, structB[k][j]-1 ) ) );
+        }
+        Assign( Elm( JVS, nElm ), sum );
+        nElm++;
+      } else {
+        if( i == j ) {
+          Assign( Elm( JVS, nElm ), Const(0) );
+          nElm++;
+        }
+      }
+    }
+  }  
+
+  FunctionEnd( JAC_VEC );
+  cellDim = 0;
+  FreeVariable( JAC_VEC );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*  Unrolled sparse LU (same row-wise elimination as KppDecomp in util/WRF_conform/sutil.f90),    */
+/*  followed by the unrolled forward/backward substitution of GenerateSolve.                      */
+/*  Singularity is not tested here; the vector integrator masks cells with a tiny pivot.          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+void GenerateDecompSolveVec()
+{
+int i, j, k, kk, jj;
+int DECOMP_VEC, SOLVE_VEC;
+int *irow;
+int *icol;
+int *crow;
+int *diag;
+int **pos;
+int useLangOld;
+int dim;
+char buf1[100];
+
+  UseFile( integratorFile );
+
+  dim  = VarNr+2;
+  irow = AllocIntegerVector( dim*dim, "irow in GenerateDecompSolveVec" );
+  icol = AllocIntegerVector( dim*dim, "icol in GenerateDecompSolveVec" );
+  crow = AllocIntegerVector( dim,     "crow in GenerateDecompSolveVec" );
+  diag = AllocIntegerVector( dim,     "diag in GenerateDecompSolveVec" );
+  pos  = AllocIntegerMatrix( dim, dim, "pos in GenerateDecompSolveVec" );
+
+  useLangOld = useLang;
+  useLang = C_LANG;
+  NonZero( LU, 0, VarNr, irow, icol, crow, diag );
+  useLang = useLangOld;
+
+  for( i = 0; i < VarNr; i++ )
+    for( kk = crow[i]; kk < crow[i+1]; kk++ )
+      pos[i][ icol[kk] ] = kk;
+
+  cellDim = NVC;
+
+  sprintf( buf1, "%s_KppDecomp_Vec", rootFileName ); 
+  DECOMP_VEC = DefFnc( buf1, 2, "sparse LU factorization - cell-vector form");
+  FunctionBegin( DECOMP_VEC, NVC, JVS );
+
+  for( k = 0; k < VarNr; k++ ) {
+    for( kk = crow[k]; kk < diag[k]; kk++ ) {
+      j = icol[kk];
+      Assign( Elm( JVS, kk ), Div( Elm( JVS, kk ), Elm( JVS, diag[j] ) ) );
+      for( jj = diag[j]+1; jj < crow[j+1]; jj++ ) {
+        i = pos[k][ icol[jj] ];
+        Assign( Elm( JVS, i ), 
+                Sub( Elm( JVS, i ), Mul( Elm( JVS, kk ), Elm( JVS, jj ) ) ) );
+      }
+    }
+  }
+
+  FunctionEnd( DECOMP_VEC );
+  FreeVariable( DECOMP_VEC );
+
+  sprintf( buf1, "%s_KppSolve_Vec", rootFileName ); 
+  SOLVE_VEC = DefFnc( buf1, 3, "sparse back substitution - cell-vector form");
+  FunctionBegin( SOLVE_VEC, NVC, JVS, X );
+
+  WriteSolveBody( icol, crow, diag );
+
+  FunctionEnd( SOLVE_VEC );
+  FreeVariable( SOLVE_VEC );
+
+  cellDim = 0;
+
+  free(irow); 
+  free(icol); 
+  free(crow); 
+  free(diag); 
+  FreeIntegerMatrix( pos, dim, dim );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+void GenerateIntegratorVec()
+{
+int INTEGRATE_VEC;
+
+  UseFile( integratorFile );
+
+  INTEGRATE_VEC = DefFnc( "INTEGRATE_VEC", 0, "Cell-vector Rosenbrock integrator");  
+  CommentFunctionBegin( INTEGRATE_VEC );
+
+  printf( "\n \n KPP is using the WRF conform cell-vector integrator routine: \n %s/int/WRF_conform/rosenbrock_vec \n", Home );
+  IncludeCode( "%s/int/WRF_conform/rosenbrock_vec", Home );
+
+  CommentFunctionEnd( INTEGRATE_VEC );
+  FreeVariable( INTEGRATE_VEC );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+void GenerateCellVector()
+{
+  if ( !useCellVector ) return;
+
+  if ( !useWRFConform || (useLang != F90_LANG) || (useJacobian != JAC_LU_ROW) ) {
+    printf("\nWarning: #CELLVECTOR requires #WRFCONFORM, Fortran90 and #JACOBIAN SPARSE_LU_ROW; ignored");
+    return;
+  }
+
+  NVC = DefElm( "NVC", INT, "Number of grid cells in the vector block" );
+
+  printf("\nKPP is generating the cell-vector kernels:");
+  printf("\n    - %s_Fun_Vec\n    - %s_Jac_SP_Vec",rootFileName,rootFileName);
+  printf("\n    - %s_KppDecomp_Vec\n    - %s_KppSolve_Vec",rootFileName,rootFileName);
+  GenerateFunVec();
+  GenerateJacVec();
+  GenerateDecompSolveVec();
+  GenerateIntegratorVec();
+
+  FreeVariable( NVC );
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 void GenerateRateLaws()
 {
@@ -3478,6 +3743,8 @@ int n;
        }  
     }
  }
+
+  GenerateCellVector();
  
  GenerateBlas();
 
@@ -72,6 +72,7 @@
 %token HESSIAN STOICMAT STOCHASTIC
 %token INITVALUES EQUATIONS LUMP INIEQUAL EQNEQUAL EQNCOLON 
 %token LMPCOLON LMPPLUS SPCPLUS SPCEQUAL ATOMDECL CHECK CHECKALL REORDER
+%token CELLVECTOR
 %token MEX DUMMYINDEX EQNTAGS 
 %token LOOKAT LOOKATALL TRANSPORT TRANSPORTALL MONITOR USES SPARSEDATA 
 %token WRFCONFORM
@@ -107,6 +108,9 @@ section	        : JACOBIAN PARAMETER
                 | REORDER PARAMETER
 		  { CmdReorder( $2 );
                   }
+                | CELLVECTOR PARAMETER
+		  { CmdCellVector( $2 );
+                  }
                 | MEX PARAMETER
 		  { CmdMex( $2 );
                   }
@@ -105,6 +105,7 @@ int useEqntags     = 0;
 int useLang        = F77_LANG;
 int useStochastic  = 0;
 int useWRFConform  = 0;
+int useCellVector  = 0;
 
 
 char integrator[ MAX_PATH ] = "none";
@@ -264,6 +265,19 @@ void CmdReorder( char *cmd )
   ScanError("'%s': Unknown parameter for #REORDER [ON|OFF]", cmd );
 }
 
+void CmdCellVector( char *cmd )
+{
+  if( EqNoCase( cmd, "OFF" ) ) {
+    useCellVector = 0;
+    return;
+  }
+  if( EqNoCase( cmd, "ON" ) ) {
+    useCellVector = 1;
+    return;
+  }
+  ScanError("'%s': Unknown parameter for #CELLVECTOR [ON|OFF]", cmd );
+}
+
 void CmdMex( char *cmd )
 {
   if( EqNoCase( cmd, "OFF" ) ) {
@@ -347,3 +347,101 @@ wki_one_d_vars( FILE * ofile,   knode_t * pp )
 
 
 
+
+
+/* chemistry load balancing (chem_lb_opt = 1, see chem/module_chem_lb.F) */
+
+int 
+decl_lb (  FILE * ofile )
+{
+
+ fprintf(ofile,"    INTEGER :: lb_nrec, lb_ncell, lb_n\n"); 
+ fprintf(ofile,"    REAL(KIND=dp), ALLOCATABLE, DIMENSION(:,:) :: lb_buf\n\n"); 
+
+}
+
+
+int
+wki_lb_start( FILE * ofile )
+{
+
+   fprintf(ofile,"\n    IF ( chem_lb_on( id ) ) THEN\n\n");
+   fprintf(ofile,"    lb_nrec  = NVAR + NFIX + NREACT\n");
+   fprintf(ofile,"    lb_ncell = (ite-its+1) * (kte-kts+1) * (jte-jts+1)\n");
+   fprintf(ofile,"    ALLOCATE( lb_buf(lb_nrec,lb_ncell) )\n");
+   fprintf(ofile,"    lb_n = 0\n\n");
+}
+
+
+int
+wki_lb_pack( FILE * ofile )
+{
+
+   fprintf(ofile,"\n    lb_n = lb_n + 1\n");
+   fprintf(ofile,"    lb_buf(1:NVAR,lb_n) = var(1:NVAR)\n");
+   fprintf(ofile,"    lb_buf(NVAR+1:NVAR+NFIX,lb_n) = fix(1:NFIX)\n");
+   fprintf(ofile,"    lb_buf(NVAR+NFIX+1:lb_nrec,lb_n) = RCONST(1:NREACT)\n");
+}
+
+
+int
+wki_lb_integrate( FILE * ofile, char * mech )
+{
+
+   fprintf(ofile,"\n    CALL chem_lb_integrate( id, lb_ncell, lb_nrec, lb_buf, dtstepc, %s_lb_cells )\n", mech);
+   fprintf(ofile,"    lb_n = 0\n\n");
+}
+
+
+int
+wki_lb_unpack( FILE * ofile )
+{
+
+   fprintf(ofile,"\n    lb_n = lb_n + 1\n");
+   fprintf(ofile,"    var(1:NVAR) = lb_buf(1:NVAR,lb_n)\n");
+   fprintf(ofile,"    RCONST(1:NREACT) = lb_buf(NVAR+NFIX+1:lb_nrec,lb_n)\n\n");
+}
+
+
+int
+wki_lb_end( FILE * ofile )
+{
+
+   fprintf(ofile,"    DEALLOCATE( lb_buf )\n\n");
+   fprintf(ofile,"    ELSE\n\n");
+}
+
+
+/* integrates a batch of packed cells, local or migrated from another task */
+
+int
+gen_lb_cells( FILE * ofile, char * mech )
+{
+
+   fprintf(ofile,"\n\nSUBROUTINE  %s_lb_cells( ncell, ld, buf, nstep, dtstepc )\n\n", mech);
+   fprintf(ofile,"    IMPLICIT NONE\n\n");
+   fprintf(ofile,"    INTEGER, INTENT(IN) :: ncell, ld\n");
+   fprintf(ofile,"    REAL(KIND=dp), DIMENSION(ld,ncell), INTENT(INOUT) :: buf\n");
+   fprintf(ofile,"    INTEGER, DIMENSION(ncell), INTENT(OUT) :: nstep\n");
+   fprintf(ofile,"    REAL, INTENT(IN) :: dtstepc\n\n");
+
+   decl_misc ( ofile );
+
+   fprintf(ofile,"\n");
+   wki_prelim ( ofile );
+
+   fprintf(ofile,"    DO n=1, ncell\n\n");
+   fprintf(ofile,"    var(1:NVAR) = buf(1:NVAR,n)\n");
+   fprintf(ofile,"    fix(1:NFIX) = buf(NVAR+1:NVAR+NFIX,n)\n");
+   fprintf(ofile,"    RCONST(1:NREACT) = buf(NVAR+NFIX+1:NVAR+NFIX+NREACT,n)\n");
+
+   fprintf(ofile, "\n  CALL %s_INTEGRATE(TIME_START, TIME_END, &  \n", mech );
+   fprintf(ofile, "          FIX, VAR,  RCONST, ATOL, RTOL, IRR_WRK, & \n");
+   fprintf(ofile, "          ICNTRL_U=icntrl, RCNTRL_U=rcntrl, ISTATUS_U=istatus  )\n\n");
+
+   fprintf(ofile,"    buf(1:NVAR,n) = var(1:NVAR)\n");
+   fprintf(ofile,"    nstep(n) = ISTATUS(3)\n\n");
+   fprintf(ofile,"    END DO\n\n");
+
+   fprintf(ofile,"END SUBROUTINE  %s_lb_cells\n", mech);
+}
@@ -46,6 +46,7 @@ int  is_driver;
     fprintf(kpp_if,"  USE %s_Integrator\n\n",p2->name );
 
     fprintf(kpp_if,"  USE module_wkppc_constants\n\n" );
+    fprintf(kpp_if,"  USE module_chem_lb, ONLY : chem_lb_on, chem_lb_integrate\n\n" );
     if( !strcmp( p2->name,"mozcart" ) || !strcmp( p2->name,"t1_mozcart" ) 
         || !strcmp( p2->name,"mozart_mosaic_4bin" ) || !strcmp( p2->name,"mozart_mosaic_4bin_aq" ) ) 
       fprintf(kpp_if,"  USE module_irr_diag\n" );
@@ -87,6 +88,9 @@ int  is_driver;
      /* declare misc variables (esp. for kpp) */
       decl_misc ( kpp_if );
 
+     /* buffer for chemistry load balancing */
+      if ( is_driver ) decl_lb ( kpp_if );
+
   
    fprintf(kpp_if,"\n#include <kpp_mechd_l_%s.inc> \n\n\n",p2->name );
 
@@ -103,6 +107,46 @@ int  is_driver;
       fprintf(kpp_if,"\n\n");
       fprintf(kpp_if,"\n#include <kpp_mechd_b_%s.inc> \n\n\n",p2->name );
    
+       /* optionally integrate the patch as one batch, redistributed
+          across tasks by chem/module_chem_lb.F (not for mechanisms
+          collecting IRR diagnostics, these need IRR_WRK per cell) */
+       if ( is_driver ) {
+
+       wki_lb_start ( kpp_if );
+
+       wki_start_loop ( kpp_if );
+       wki_one_d_vars ( kpp_if,  p1 );
+       gen_map_jval ( kpp_if );
+       gen_map_wrf_to_kpp ( kpp_if, p1 );
+
+        fprintf(kpp_if,"\n#include <kpp_mechd_ibu_%s.inc> \n\n",p2->name );
+
+            fprintf(kpp_if, "\n\n\n\n   CALL %s_Update_Rconst(  &\n", p2->name );
+            fprintf(kpp_if, "!\n");
+            fprintf(kpp_if, "#include <extra_args_to_update_rconst_%s.inc>\n", p2->name);
+            fprintf(kpp_if, "!\n");
+            fprintf(kpp_if, "#include <args_to_update_rconst.inc>\n");
+            fprintf(kpp_if, "!\n)\n\n");
+
+        fprintf(kpp_if,"\n#include <kpp_mechd_ib_%s.inc> \n\n",p2->name );
+
+       wki_lb_pack ( kpp_if );
+       wki_end_loop( kpp_if );
+
+       wki_lb_integrate ( kpp_if, p2->name );
+
+       wki_start_loop ( kpp_if );
+       wki_lb_unpack ( kpp_if );
+       wki_one_d_vars ( kpp_if,  p1 );
+
+       fprintf(kpp_if,"\n#include <kpp_mechd_ia_%s.inc> \n\n",p2->name );
+
+        gen_map_kpp_to_wrf ( kpp_if, p1 );
+       wki_end_loop( kpp_if );
+
+       wki_lb_end ( kpp_if );
+       }
+
        /* start loop over 3-D fields */
        wki_start_loop ( kpp_if );
 
@@ -154,11 +198,16 @@ int  is_driver;
        /* end loop over 3-D fields */
        wki_end_loop( kpp_if );
 
+       if ( is_driver ) fprintf(kpp_if,"    END IF\n\n");
+
 
       fprintf(kpp_if,"\n\n");
       fprintf(kpp_if,"\n#include <kpp_mechd_a_%s.inc> \n\n\n",p2->name );
 
     fprintf(kpp_if,"\n\nEND SUBROUTINE  %s_interface\n",p2->name ); 
+
+    /* batch integration callback for chem_lb_integrate */
+    if ( is_driver ) gen_lb_cells ( kpp_if, p2->name );
     fprintf(kpp_if,"\n\nEND MODULE module_kpp_%s_interf \n",p2->name ); 
 
     fprintf(kpp_if,"\n#include <kpp_mechd_e_%s.inc> \n\n\n",p2->name );
@@ -59,6 +59,13 @@ int wki_prelim( FILE * ofile );
 int wki_start_loop( FILE * ofile );
 int wki_end_loop( FILE * ofile );
 int wki_one_d_vars ( FILE * ofile, knode_t * pp );
+int decl_lb (  FILE * ofile );
+int wki_lb_start( FILE * ofile );
+int wki_lb_pack( FILE * ofile );
+int wki_lb_integrate( FILE * ofile, char * mech );
+int wki_lb_unpack( FILE * ofile );
+int wki_lb_end( FILE * ofile );
+int gen_lb_cells( FILE * ofile, char * mech );
 
 #define PROTOS_H_KPP
 #endif
@@ -938,6 +938,35 @@ RSL_LITE_PACK_AD ( int * Fcomm0, char * buf , int * shw0 ,
 #ifndef STUBMPI
 static MPI_Request yp_recv, ym_recv, yp_send, ym_send ;
 static MPI_Request xp_recv, xm_recv, xp_send, xm_send ;
+
+/* with compression on (rsl_compress.c), halo messages travel through
+   these scratch buffers; index 0 is the minus side, 1 the plus side */
+static char * zsend[2] = { NULL, NULL }, * zrecv[2] = { NULL, NULL } ;
+static int zsend_size[2] = { 0, 0 }, zrecv_size[2] = { 0, 0 } ;
+
+static char *
+exch_recvbuf ( int side, int P, int * n )
+{
+  if ( ! rsl_compress_on() ) return( buffer_for_proc( P, *n, RSL_RECVBUF ) ) ;
+  *n += RSL_Z_HEADER ;
+  return( rsl_compress_buf( &zrecv[side], &zrecv_size[side], *n ) ) ;
+}
+
+static char *
+exch_sendbuf ( int side, int P, int * n )
+{
+  char * p = buffer_for_proc( P, 0, RSL_SENDBUF ) ;
+  if ( ! rsl_compress_on() ) return( p ) ;
+  rsl_compress_buf( &zsend[side], &zsend_size[side], *n+RSL_Z_HEADER ) ;
+  *n = rsl_compress( p, *n, zsend[side] ) ;
+  return( zsend[side] ) ;
+}
+
+static void
+exch_recvdone ( int side, int P, int n )
+{
+  if ( rsl_compress_on() ) rsl_decompress( zrecv[side], buffer_for_proc( P, n, RSL_RECVBUF ) ) ;
+}
 #endif
 
 RSL_LITE_EXCH_Y ( int * Fcomm0, int *me0, int * np0 , int * np_x0 , int * np_y0 ,
@@ -946,6 +975,8 @@ RSL_LITE_EXCH_Y ( int * Fcomm0, int *me0, int * np0 , int * np_x0 , int * np_y0
   int me, np, np_x, np_y ;
   int yp, ym, xp, xm, ierr ;
 #ifndef STUBMPI
+  char * rbuf, * sbuf ;
+  int n ;
   MPI_Status stat ;
   MPI_Comm comm, *comm0, dummy_comm ;
 
@@ -955,19 +986,27 @@ RSL_LITE_EXCH_Y ( int * Fcomm0, int *me0, int * np0 , int * np_x0 , int * np_y0
   if ( np_y > 1 ) {
     MPI_Cart_shift( *comm0, 0, 1, &ym, &yp ) ;
     if ( yp != MPI_PROC_NULL && *recvw_p > 0 ) {
-      ierr=MPI_Irecv ( buffer_for_proc( yp, yp_curs_recv, RSL_RECVBUF ), yp_curs_recv, MPI_CHAR, yp, me, comm, &yp_recv ) ;
+      n = yp_curs_recv ;
+      rbuf = exch_recvbuf( 1, yp, &n ) ;
+      ierr=MPI_Irecv ( rbuf, n, MPI_CHAR, yp, me, comm, &yp_recv ) ;
     }
     if ( ym != MPI_PROC_NULL && *recvw_m > 0 ) {
-      ierr=MPI_Irecv ( buffer_for_proc( ym, ym_curs_recv, RSL_RECVBUF ), ym_curs_recv, MPI_CHAR, ym, me, comm, &ym_recv ) ;
+      n = ym_curs_recv ;
+      rbuf = exch_recvbuf( 0, ym, &n ) ;
+      ierr=MPI_Irecv ( rbuf, n, MPI_CHAR, ym, me, comm, &ym_recv ) ;
     }
     if ( yp != MPI_PROC_NULL && *sendw_p > 0 ) {
-      ierr=MPI_Isend ( buffer_for_proc( yp, 0,       RSL_SENDBUF ), yp_curs, MPI_CHAR, yp, yp, comm, &yp_send ) ;
+      n = yp_curs ;
+      sbuf = exch_sendbuf( 1, yp, &n ) ;
+      ierr=MPI_Isend ( sbuf, n, MPI_CHAR, yp, yp, comm, &yp_send ) ;
     }
     if ( ym != MPI_PROC_NULL && *sendw_m > 0 ) {
-      ierr=MPI_Isend ( buffer_for_proc( ym, 0,       RSL_SENDBUF ), ym_curs, MPI_CHAR, ym, ym, comm, &ym_send ) ;
+      n = ym_curs ;
+      sbuf = exch_sendbuf( 0, ym, &n ) ;
+      ierr=MPI_Isend ( sbuf, n, MPI_CHAR, ym, ym, comm, &ym_send ) ;
     }
-    if ( yp != MPI_PROC_NULL && *recvw_p > 0 ) {  MPI_Wait( &yp_recv, &stat ) ;  }
-    if ( ym != MPI_PROC_NULL && *recvw_m > 0 ) {  MPI_Wait( &ym_recv, &stat ) ;  }
+    if ( yp != MPI_PROC_NULL && *recvw_p > 0 ) {  MPI_Wait( &yp_recv, &stat ) ; exch_recvdone( 1, yp, yp_curs_recv ) ;  }
+    if ( ym != MPI_PROC_NULL && *recvw_m > 0 ) {  MPI_Wait( &ym_recv, &stat ) ; exch_recvdone( 0, ym, ym_curs_recv ) ;  }
     if ( yp != MPI_PROC_NULL && *sendw_p > 0 ) {  MPI_Wait( &yp_send, &stat ) ;  }
     if ( ym != MPI_PROC_NULL && *sendw_m > 0 ) {  MPI_Wait( &ym_send, &stat ) ;  }
   }
@@ -983,6 +1022,8 @@ RSL_LITE_EXCH_X ( int * Fcomm0, int *me0, int * np0 , int * np_x0 , int * np_y0
   int me, np, np_x, np_y ;
   int yp, ym, xp, xm ;
 #ifndef STUBMPI
+  char * rbuf, * sbuf ;
+  int n ;
   MPI_Status stat ;
   MPI_Comm comm, *comm0, dummy_comm ;
 
@@ -992,19 +1033,27 @@ RSL_LITE_EXCH_X ( int * Fcomm0, int *me0, int * np0 , int * np_x0 , int * np_y0
   if ( np_x > 1 ) {
     MPI_Cart_shift( *comm0, 1, 1, &xm, &xp ) ;
     if ( xp != MPI_PROC_NULL && *recvw_p > 0 ) {
-      MPI_Irecv ( buffer_for_proc( xp, xp_curs_recv, RSL_RECVBUF ), xp_curs_recv, MPI_CHAR, xp, me, comm, &xp_recv ) ;
+      n = xp_curs_recv ;
+      rbuf = exch_recvbuf( 1, xp, &n ) ;
+      MPI_Irecv ( rbuf, n, MPI_CHAR, xp, me, comm, &xp_recv ) ;
     }
     if ( xm != MPI_PROC_NULL && *recvw_m > 0 ) {
-      MPI_Irecv ( buffer_for_proc( xm, xm_curs_recv, RSL_RECVBUF ), xm_curs_recv, MPI_CHAR, xm, me, comm, &xm_recv ) ;
+      n = xm_curs_recv ;
+      rbuf = exch_recvbuf( 0, xm, &n ) ;
+      MPI_Irecv ( rbuf, n, MPI_CHAR, xm, me, comm, &xm_recv ) ;
     }
     if ( xp != MPI_PROC_NULL && *sendw_p > 0 ) {
-      MPI_Isend ( buffer_for_proc( xp, 0,       RSL_SENDBUF ), xp_curs, MPI_CHAR, xp, xp, comm, &xp_send ) ;
+      n = xp_curs ;
+      sbuf = exch_sendbuf( 1, xp, &n ) ;
+      MPI_Isend ( sbuf, n, MPI_CHAR, xp, xp, comm, &xp_send ) ;
     }
     if ( xm != MPI_PROC_NULL && *sendw_m > 0 ) {
-      MPI_Isend ( buffer_for_proc( xm, 0,       RSL_SENDBUF ), xm_curs, MPI_CHAR, xm, xm, comm, &xm_send ) ;
+      n = xm_curs ;
+      sbuf = exch_sendbuf( 0, xm, &n ) ;
+      MPI_Isend ( sbuf, n, MPI_CHAR, xm, xm, comm, &xm_send ) ;
     }
-    if ( xp != MPI_PROC_NULL && *recvw_p > 0 ) {  MPI_Wait( &xp_recv, &stat ) ;  }
-    if ( xm != MPI_PROC_NULL && *recvw_m > 0 ) {  MPI_Wait( &xm_recv, &stat ) ;  }
+    if ( xp != MPI_PROC_NULL && *recvw_p > 0 ) {  MPI_Wait( &xp_recv, &stat ) ; exch_recvdone( 1, xp, xp_curs_recv ) ;  }
+    if ( xm != MPI_PROC_NULL && *recvw_m > 0 ) {  MPI_Wait( &xm_recv, &stat ) ; exch_recvdone( 0, xm, xm_curs_recv ) ;  }
     if ( xp != MPI_PROC_NULL && *sendw_p > 0 ) {  MPI_Wait( &xp_send, &stat ) ;  }
     if ( xm != MPI_PROC_NULL && *sendw_m > 0 ) {  MPI_Wait( &xm_send, &stat ) ;  }
   }
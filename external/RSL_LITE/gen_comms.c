@@ -14,6 +14,9 @@
 #define NULLCHARPTR   (char *) 0
 static int parent_type;
 
+/* when > 0, gen_packs_halo guards 2d and 3d fields with wrf_dm_halo_send at this width */
+static int halo_elide_width = 0 ;
+
 /* print actual and dummy arguments and declarations for 4D and i1 arrays */
 #if ( WRFPLUS == 1 )
 int print_4d_i1_decls ( FILE *fp , node_t *p, int ad /* 0=argument,1=declaration */, int du /* 0=dummy,1=actual */, int nta /* 0=NLM,1=TLM,2=ADM */)   
@@ -249,6 +252,7 @@ int print_decl( FILE * fp , node_t *p, char * communicator,
   fprintf(fp,"  INTEGER :: rsl_sendw_p, rsl_sendbeg_p, rsl_recvw_p, rsl_recvbeg_p\n") ;
   fprintf(fp,"  INTEGER :: rsl_sendw_m, rsl_sendbeg_m, rsl_recvw_m, rsl_recvbeg_m\n") ;
   fprintf(fp,"  LOGICAL, EXTERNAL :: rsl_comm_iter\n") ;
+  fprintf(fp,"  LOGICAL, EXTERNAL :: wrf_dm_halo_send\n") ;
   fprintf(fp,"  INTEGER :: idim1, idim2, idim3, idim4, idim5, idim6, idim7\n") ;
   return 0; /* SamT: bug fix: return a value */
   }
@@ -596,6 +600,14 @@ fprintf(fp,"CALL wrf_debug(3,'calling RSL_LITE_INIT_EXCH %s for Y %s')\n",maxste
       fprintf(fp,"(ips-1)*grid%%sr_x+1,ipe*grid%%sr_x,(jps-1)*grid%%sr_y+1,jpe*grid%%sr_y,kps,kpe)\n") ;
     }
 
+/* fields whose halos are still current may be left out; not for shifts or nest forcing */
+    halo_elide_width = 0 ;
+    if ( incname == NULL && maxstenwidth_int > 0 &&
+         strcmp(commname,"HALO_INTERP_DOWN") && strcmp(commname,"HALO_FORCE_DOWN") &&
+         strcmp(commname,"HALO_INTERP_UP"  ) && strcmp(commname,"HALO_INTERP_SMOOTH") ) {
+      halo_elide_width = maxstenwidth_int ;
+    }
+
 /* generate packs prior to stencil exchange in Y */
 #if ( WRFPLUS == 1 )
     gen_packs_halo( fp, p, maxstenwidth, 0, 0, 0, "RSL_LITE_PACK", "local_communicator", always_interp_mp ) ;
@@ -660,6 +672,10 @@ fprintf(fp,"CALL wrf_debug(3,'calling RSL_LITE_INIT_EXCH %s for Y %s')\n",maxste
     gen_packs_halo( fp, p, maxstenwidth, 1, 1, "RSL_LITE_PACK", "local_communicator", always_interp_mp ) ;
 #endif
     fprintf(fp,"    ENDDO\n") ; 
+    if ( halo_elide_width > 0 ) {
+      gen_halo_sent( fp, p, commname ) ;
+      halo_elide_width = 0 ;
+    }
     if ( subgrid != 0 ) {
       fprintf(fp,"ENDIF\n") ;
     }
@@ -1208,6 +1224,59 @@ fprintf(fp,"CALL wrf_debug(3,'calling RSL_LITE_INIT_EXCH %s for Y %s')\n",maxste
 }
 #endif
 
+/* opening IF of a 2d or 3d field pack; adds the halo elision test when gen_halos asked for it */
+int
+gen_halo_guard ( FILE *fp , char *varref, int xdex, int ydex, char *varname )
+{
+  char lname[NAMELEN] ;
+  if ( halo_elide_width > 0 ) {
+    strcpy( lname, varname ) ;
+    make_lower_case( lname ) ;
+    fprintf(fp,"IF ( SIZE(%s,%d)*SIZE(%s,%d) .GT. 1 .AND. &\n     wrf_dm_halo_send(grid%%id,'%s',%d) ) THEN\n",
+            varref,xdex+1,varref,ydex+1,lname,halo_elide_width ) ;
+  } else {
+    fprintf(fp,"IF ( SIZE(%s,%d)*SIZE(%s,%d) .GT. 1 ) THEN\n",varref,xdex+1,varref,ydex+1 ) ;
+  }
+  return(0) ;
+}
+
+/* after the exchange: record what was sent for each 2d and 3d field, then tally the halo */
+int
+gen_halo_sent ( FILE *fp , node_t *p, char *commname )
+{
+  node_t * q ;
+  char tmp[NAMELEN_LONG], tmp2[NAMELEN_LONG] ;
+  char lname[NAMELEN] ;
+  char * t1, * t2 ;
+  char * pos1 , * pos2 ;
+
+  strcpy( tmp, p->comm_define ) ;
+  t1 = strtok_rentr( tmp , ";" , &pos1 ) ;
+  while ( t1 != NULL )
+  {
+    strcpy( tmp2 , t1 ) ;
+    if (( t2 = strtok_rentr( tmp2 , ":" , &pos2 )) != NULL ) {
+      t2 = strtok_rentr(NULL,",", &pos2) ;
+      while ( t2 != NULL )
+      {
+        if ( (q = get_entry_r( t2, p->use, Domain.fields )) != NULL &&
+             ! ( q->node_kind & FOURD ) && ! q->boundary_array &&
+             ( q->ndims == 2 || q->ndims == 3 ) &&
+             ( !strcmp( q->type->name, "real") || !strcmp( q->type->name, "integer") ||
+               !strcmp( q->type->name, "doubleprecision") ) ) {
+          strcpy( lname, t2 ) ;
+          make_lower_case( lname ) ;
+          fprintf(fp,"CALL wrf_dm_halo_sent(grid%%id,'%s',%d)\n",lname,halo_elide_width) ;
+        }
+        t2 = strtok_rentr( NULL , "," , &pos2 ) ;
+      }
+    }
+    t1 = strtok_rentr( NULL , ";" , &pos1 ) ;
+  }
+  fprintf(fp,"CALL wrf_dm_halo_done('%s')\n",commname) ;
+  return(0) ;
+}
+
 #if ( WRFPLUS == 1 )
 gen_packs_halo ( FILE *fp , node_t *p, char *shw, int xy /* 0=y,1=x */ , int pu /* 0=pack,1=unpack */, int nta /* 0=NLM,1=TLM,2=ADM*/, char * packname, char * commname, int always_interp_mp )   
 #else
@@ -1353,7 +1422,7 @@ fprintf(fp,"ENDDO\n") ;
                 xdex = get_index_for_coord( q , COORD_X ) ;
                 ydex = get_index_for_coord( q , COORD_Y ) ;
                 zdex = get_index_for_coord( q , COORD_Z ) ;
-                fprintf(fp,"IF ( SIZE(%s,%d)*SIZE(%s,%d) .GT. 1 ) THEN\n",varref,xdex+1,varref,ydex+1 ) ; 
+                gen_halo_guard( fp, varref, xdex, ydex, varname ) ;
                 fprintf(fp,"CALL %s ( %s,&\n %s, %s,&\nrsl_sendbeg_m, rsl_sendw_m, rsl_sendbeg_p, rsl_sendw_p, &\nrsl_recvbeg_m, rsl_recvw_m, rsl_recvbeg_p, rsl_recvw_p, &\n%s, %d, %d, DATA_ORDER_%s, %d, &\n", 
                         packname, commname, varref, shw, wordsize, xy, pu, memord, xy?(q->stag_x?1:0):(q->stag_y?1:0) ) ;
                 fprintf(fp,"mytask, ntasks, ntasks_x, ntasks_y,       &\n") ;
@@ -1407,7 +1476,7 @@ fprintf(fp,"(ips-1)*grid%%sr_x+1,ipe*grid%%sr_x,(jps-1)*grid%%sr_y+1,jpe*grid%%s
               } else if ( q->ndims == 2 ) {
                 xdex = get_index_for_coord( q , COORD_X ) ;
                 ydex = get_index_for_coord( q , COORD_Y ) ;
-                fprintf(fp,"IF ( SIZE(%s,%d)*SIZE(%s,%d) .GT. 1 ) THEN\n",varref,xdex+1,varref,ydex+1 ) ; 
+                gen_halo_guard( fp, varref, xdex, ydex, varname ) ;
                 fprintf(fp,"CALL %s ( %s,&\n %s, %s,&\nrsl_sendbeg_m, rsl_sendw_m, rsl_sendbeg_p, rsl_sendw_p, &\nrsl_recvbeg_m, rsl_recvw_m, rsl_recvbeg_p, rsl_recvw_p, &\n%s, %d, %d, DATA_ORDER_%s, %d, &\n", 
                        packname, commname, varref, shw, wordsize, xy, pu, memord, xy?(q->stag_x?1:0):(q->stag_y?1:0) ) ;
                 fprintf(fp,"mytask, ntasks, ntasks_x, ntasks_y,       &\n") ;
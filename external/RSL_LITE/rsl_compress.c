@@ -0,0 +1,161 @@
+#ifndef MS_SUA
+# include <stdio.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include "rsl_lite.h"
+
+/*
+   Optional lossless compression of halo messages.
+
+   A message at least rsl_compress_min bytes long is byte-shuffled on a
+   4-byte stride (byte k of every word goes to plane k, which puts the
+   sign/exponent bytes of real data next to each other) and then run-length
+   coded.  Fields that are zero or nearly constant over a halo slab, which is
+   most of them in chemistry and aerosol runs, shrink to a few bytes per
+   plane.  If the coded message would not be at least 1/8 smaller it goes
+   as is.  Every message carries an 8-byte header, the coding used and the
+   original length, so the receiver needs no other information; both sides
+   must however agree that compression is on, which is why it is set once
+   for all tasks from the dm_compress namelist.
+
+   Run-length format: a control byte c < 128 is followed by c+1 literal
+   bytes; c >= 128 is followed by one byte to be repeated c-125 times.
+*/
+
+#define RSL_Z_RAW     0
+#define RSL_Z_SHUFRLE 1
+#define RSL_Z_STRIDE  4
+
+static int rsl_compress_min = 0 ;
+static unsigned char * ztmp = NULL ;
+static int ztmp_size = 0 ;
+
+RSL_LITE_SET_COMPRESS ( int * nbytes )
+{
+  rsl_compress_min = *nbytes > 0 ? *nbytes : 0 ;
+}
+
+int
+rsl_compress_on ( void )
+{
+  return( rsl_compress_min > 0 ) ;
+}
+
+/* grow *buf to at least size bytes; contents are not kept */
+char *
+rsl_compress_buf ( char ** buf, int * cursize, int size )
+{
+  if ( *cursize < size ) {
+    if ( *buf != NULL ) RSL_FREE( *buf ) ;
+    *buf = RSL_MALLOC( char, size+512 ) ;
+    *cursize = size+512 ;
+  }
+  return( *buf ) ;
+}
+
+static void
+shuffle ( const unsigned char * in, unsigned char * out, int n )
+{
+  int nw = n / RSL_Z_STRIDE ;
+  int b, w ;
+  for ( b = 0 ; b < RSL_Z_STRIDE ; b++ )
+    for ( w = 0 ; w < nw ; w++ ) out[b*nw+w] = in[w*RSL_Z_STRIDE+b] ;
+  memcpy( out+nw*RSL_Z_STRIDE, in+nw*RSL_Z_STRIDE, n-nw*RSL_Z_STRIDE ) ;
+}
+
+static void
+unshuffle ( const unsigned char * in, unsigned char * out, int n )
+{
+  int nw = n / RSL_Z_STRIDE ;
+  int b, w ;
+  for ( b = 0 ; b < RSL_Z_STRIDE ; b++ )
+    for ( w = 0 ; w < nw ; w++ ) out[w*RSL_Z_STRIDE+b] = in[b*nw+w] ;
+  memcpy( out+nw*RSL_Z_STRIDE, in+nw*RSL_Z_STRIDE, n-nw*RSL_Z_STRIDE ) ;
+}
+
+/* returns coded length, or -1 as soon as it would exceed maxout */
+static int
+rle_encode ( const unsigned char * in, int n, unsigned char * out, int maxout )
+{
+  int i = 0, o = 0, run, lit ;
+  while ( i < n ) {
+    for ( run = 1 ; i+run < n && run < 130 && in[i+run] == in[i] ; run++ ) ;
+    if ( run >= 3 ) {
+      if ( o+2 > maxout ) return( -1 ) ;
+      out[o++] = (unsigned char)( 128+run-3 ) ;
+      out[o++] = in[i] ;
+      i += run ;
+    } else {
+      for ( lit = 0 ; i+lit < n && lit < 128 ; lit++ ) {
+        if ( i+lit+2 < n && in[i+lit] == in[i+lit+1] && in[i+lit] == in[i+lit+2] ) break ;
+      }
+      if ( o+1+lit > maxout ) return( -1 ) ;
+      out[o++] = (unsigned char)( lit-1 ) ;
+      memcpy( out+o, in+i, lit ) ;
+      o += lit ; i += lit ;
+    }
+  }
+  return( o ) ;
+}
+
+static void
+rle_decode ( const unsigned char * in, unsigned char * out, int n )
+{
+  int i = 0, o = 0, c, k ;
+  while ( o < n ) {
+    c = in[i++] ;
+    if ( c < 128 ) {
+      k = c+1 ;
+      memcpy( out+o, in+i, k ) ;
+      i += k ;
+    } else {
+      k = c-125 ;
+      memset( out+o, in[i++], k ) ;
+    }
+    o += k ;
+  }
+}
+
+/*
+   Code the n bytes at in into out, which must hold n+RSL_Z_HEADER bytes.
+   Returns the number of bytes to send.
+*/
+int
+rsl_compress ( char * in, int n, char * out )
+{
+  int hdr[2], len = -1 ;
+  hdr[0] = RSL_Z_RAW ; hdr[1] = n ;
+  if ( n >= rsl_compress_min ) {
+    rsl_compress_buf( (char **)&ztmp, &ztmp_size, n ) ;
+    shuffle( (unsigned char *)in, ztmp, n ) ;
+    len = rle_encode( ztmp, n, (unsigned char *)out+RSL_Z_HEADER, n - n/8 ) ;
+  }
+  if ( len < 0 ) {
+    memcpy( out+RSL_Z_HEADER, in, n ) ;
+    len = n ;
+  } else {
+    hdr[0] = RSL_Z_SHUFRLE ;
+  }
+  memcpy( out, hdr, RSL_Z_HEADER ) ;
+  return( len+RSL_Z_HEADER ) ;
+}
+
+/*
+   Restore a message coded by rsl_compress into out, which must hold the
+   original length.  Returns that length.
+*/
+int
+rsl_decompress ( char * in, char * out )
+{
+  int hdr[2] ;
+  memcpy( hdr, in, RSL_Z_HEADER ) ;
+  if ( hdr[0] == RSL_Z_SHUFRLE ) {
+    rsl_compress_buf( (char **)&ztmp, &ztmp_size, hdr[1] ) ;
+    rle_decode( (unsigned char *)in+RSL_Z_HEADER, ztmp, hdr[1] ) ;
+    unshuffle( ztmp, (unsigned char *)out, hdr[1] ) ;
+  } else {
+    memcpy( out, in+RSL_Z_HEADER, hdr[1] ) ;
+  }
+  return( hdr[1] ) ;
+}
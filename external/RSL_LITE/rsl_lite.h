@@ -46,6 +46,7 @@
 #endif
 #      define RSL_LITE_GET_HOSTNAME rsl_lite_get_hostname
 #      define RSL_LITE_NESTING_RESET rsl_lite_nesting_reset
+#      define RSL_LITE_SET_COMPRESS rsl_lite_set_compress
 # else
 #   ifdef F2CSTYLE
 #      define RSL_LITE_ERROR_DUP1 rsl_error_dup1__
@@ -94,6 +95,7 @@
 #endif
 #      define RSL_LITE_GET_HOSTNAME rsl_lite_get_hostname__
 #      define RSL_LITE_NESTING_RESET rsl_lite_nesting_reset__
+#      define RSL_LITE_SET_COMPRESS rsl_lite_set_compress__
 #   else
 #      define RSL_LITE_ERROR_DUP1 rsl_error_dup1_
 #      define BYTE_BCAST byte_bcast_
@@ -141,6 +143,7 @@
 #endif
 #      define RSL_LITE_GET_HOSTNAME rsl_lite_get_hostname_
 #      define RSL_LITE_NESTING_RESET rsl_lite_nesting_reset_
+#      define RSL_LITE_SET_COMPRESS rsl_lite_set_compress_
 #   endif
 # endif
 #endif
@@ -164,6 +167,13 @@
 #define RSL_FREE(P)      rsl_free(&(P))
 
 char * buffer_for_proc ( int P, int size, int code ) ;
+
+/* rsl_compress.c: optional coding of halo messages, see RSL_LITE_SET_COMPRESS */
+#define RSL_Z_HEADER (2*sizeof(int))
+int rsl_compress_on ( void ) ;
+char * rsl_compress_buf ( char ** buf, int * cursize, int size ) ;
+int rsl_compress ( char * in, int n, char * out ) ;
+int rsl_decompress ( char * in, char * out ) ;
 void * rsl_malloc( char * f, int l, int s ) ;
 typedef int * int_p ;
 
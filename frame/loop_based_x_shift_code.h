@@ -1,6 +1,7 @@
       p => grid%head_statevars%next
       DO WHILE ( ASSOCIATED( p ) ) 
-        IF ( p%ProcOrient .NE. 'X' .AND. p%ProcOrient .NE. 'Y' ) THEN
+        IF ( p%ProcOrient .NE. 'X' .AND. p%ProcOrient .NE. 'Y' .AND. &
+             .NOT. ( ASSOCIATED( p%rstore ) .OR. ASSOCIATED( p%dstore ) .OR. ASSOCIATED( p%istore ) ) ) THEN
           IF ( INDEX(TRIM(p%Stagger),'X') .GT. 0 ) THEN
             ipf = MIN(ipe,ide)
           ELSE
@@ -13,6 +13,7 @@
 #      define ADD_TO_BUFSIZE_FOR_FIELD_C  add_to_bufsize_for_field_c
 #      define STORE_PIECE_OF_FIELD_C  store_piece_of_field_c
 #      define RETRIEVE_PIECES_OF_FIELD_C  retrieve_pieces_of_field_c
+#      define RETRIEVE_PIECES_OF_FIELDS_C  retrieve_pieces_of_fields_c
 #      define INIT_STORE_PIECE_OF_FIELD init_store_piece_of_field
 #      define INIT_RETRIEVE_PIECES_OF_FIELD init_retrieve_pieces_of_field
 #      define PERTURB_REAL perturb_real
@@ -28,6 +29,7 @@
 #      define ADD_TO_BUFSIZE_FOR_FIELD_C  add_to_bufsize_for_field_c__
 #      define STORE_PIECE_OF_FIELD_C  store_piece_of_field_c__
 #      define RETRIEVE_PIECES_OF_FIELD_C  retrieve_pieces_of_field_c__
+#      define RETRIEVE_PIECES_OF_FIELDS_C  retrieve_pieces_of_fields_c__
 #      define INIT_STORE_PIECE_OF_FIELD init_store_piece_of_field__
 #      define INIT_RETRIEVE_PIECES_OF_FIELD init_retrieve_pieces_of_field__
 #      define PERTURB_REAL perturb_real__
@@ -42,6 +44,7 @@
 #      define ADD_TO_BUFSIZE_FOR_FIELD_C  add_to_bufsize_for_field_c_
 #      define STORE_PIECE_OF_FIELD_C  store_piece_of_field_c_
 #      define RETRIEVE_PIECES_OF_FIELD_C  retrieve_pieces_of_field_c_
+#      define RETRIEVE_PIECES_OF_FIELDS_C  retrieve_pieces_of_fields_c_
 #      define INIT_STORE_PIECE_OF_FIELD init_store_piece_of_field_
 #      define INIT_RETRIEVE_PIECES_OF_FIELD init_retrieve_pieces_of_field_
 #      define PERTURB_REAL perturb_real_
@@ -111,32 +114,115 @@ INT_GET_TI_HEADER_C ( char * hdrbuf, int * hdrbufsize, int * n,  /* hdrbufsize a
   return(0) ;
 }
 
-#define MAX_FLDS 2000
-static char fld_name[MAX_FLDS][256] ;
-static char *fld_cache[MAX_FLDS] ;
-static int fld_curs[MAX_FLDS] ;
-static int fld_bufsize[MAX_FLDS] ;
+/*
+   Named field buffers for the I/O servers.  Entries are kept in the order
+   they were first added, which is the order they are retrieved in (every
+   server in a group has to agree on it), and are found by name through an
+   open-addressed hash table so a lookup costs the same however many fields
+   a frame has.  Both tables grow as needed; there is no limit on the number
+   of fields.
+*/
+typedef struct {
+  char name[256] ;
+  char *cache ;
+  int curs ;
+  int bufsize ;
+} fld_t ;
+
+static fld_t *flds = NULL ;
+static int maxflds = 0 ;
+static int *fld_hash = NULL ;   /* 1 + index into flds; 0 is an empty slot */
+static int hashsize = 0 ;       /* power of 2, kept at 4 * maxflds */
 static int fld     = 0 ;
 static int numflds = 0 ;
-static int frst = 1 ;
 
-int INIT_STORE_PIECE_OF_FIELD ()
+static unsigned int
+fld_hashval ( const char * s )
 {
-  int i ;
-  if ( frst ) {
-    for ( i = 0 ; i < MAX_FLDS ; i++ ) {
-      fld_cache[i] = NULL ;
+  unsigned int h = 2166136261u ;
+  while ( *s ) { h ^= (unsigned char) *s++ ; h *= 16777619u ; }
+  return(h) ;
+}
+
+static void
+fld_hash_insert ( int i )
+{
+  unsigned int h ;
+  for ( h = fld_hashval( flds[i].name ) & (hashsize-1) ; fld_hash[h] != 0 ; h = (h+1) & (hashsize-1) ) ;
+  fld_hash[h] = i+1 ;
+}
+
+static void
+fld_hash_clear ()
+{
+  if ( fld_hash != NULL ) memset( fld_hash, 0, hashsize*sizeof(int) ) ;
+}
+
+static int
+fld_lookup ( const char * vname )
+{
+  unsigned int h ;
+  int j ;
+  if ( hashsize == 0 ) return(-1) ;
+  for ( h = fld_hashval( vname ) & (hashsize-1) ; (j = fld_hash[h]) != 0 ; h = (h+1) & (hashsize-1) ) {
+    if ( !strcmp( flds[j-1].name, vname ) ) return(j-1) ;
+  }
+  return(-1) ;
+}
+
+static int
+fld_add ( const char * vname )
+{
+  int i, newmax ;
+  fld_t *newflds ;
+  int *newhash ;
+
+  if ( numflds >= maxflds ) {
+    newmax = ( maxflds > 0 ) ? 2*maxflds : 512 ;
+    newflds = (fld_t *) realloc( flds, newmax*sizeof(fld_t) ) ;
+    newhash = (int *) malloc( 4*newmax*sizeof(int) ) ;
+    if ( newflds == NULL || newhash == NULL ) {
+#ifndef MS_SUA
+      fprintf(stderr,"frame/pack_utils.c: cannot grow field table past %d entries\n",maxflds ) ;
+#endif
+      if ( newflds != NULL ) flds = newflds ;
+      if ( newhash != NULL ) free( newhash ) ;
+      return(-1) ;
+    }
+    flds = newflds ;
+    for ( i = maxflds ; i < newmax ; i++ ) {
+      strcpy( flds[i].name, "" ) ;
+      flds[i].cache = NULL ;
+      flds[i].curs = 0 ;
+      flds[i].bufsize = 0 ;
     }
-    frst = 0 ; 
+    maxflds = newmax ;
+    if ( fld_hash != NULL ) free( fld_hash ) ;
+    fld_hash = newhash ;
+    hashsize = 4*newmax ;
+    fld_hash_clear() ;
+    for ( i = 0 ; i < numflds ; i++ ) fld_hash_insert( i ) ;
   }
+  i = numflds++ ;
+  strcpy( flds[i].name, vname ) ;
+  flds[i].curs = 0 ;
+  flds[i].bufsize = 0 ;
+  fld_hash_insert( i ) ;
+  return(i) ;
+}
+
+int INIT_STORE_PIECE_OF_FIELD ()
+{
+  int i ;
   numflds = 0 ;
-  for ( i = 0 ; i < MAX_FLDS ; i++ ) {
-    strcpy( fld_name[i], "" ) ;
-    if ( fld_cache[i] != NULL ) free( fld_cache[i] ) ;
-    fld_cache[i] = NULL ;
-    fld_curs[i] = 0 ;
-    fld_bufsize[i] = 0 ;
+  for ( i = 0 ; i < maxflds ; i++ ) {
+    strcpy( flds[i].name, "" ) ;
+    if ( flds[i].cache != NULL ) free( flds[i].cache ) ;
+    flds[i].cache = NULL ;
+    flds[i].curs = 0 ;
+    flds[i].bufsize = 0 ;
   }
+  fld_hash_clear() ;
   return(0) ;
 }
 
@@ -157,19 +243,17 @@ ADD_TO_BUFSIZE_FOR_FIELD_C ( int varname[], int * chunksize )
   for ( i = 1; i <= n ; i++ ) { vname[i-1] = varname[i] ; }
   vname[n] = '\0' ;
 
-  found = -1 ;
-  for ( i = 0 ; i < numflds ; i++ ) { if ( !strcmp( fld_name[i], vname ) ) { found = i ; break ; } }
+  found = fld_lookup( vname ) ;
   if ( found == -1 ) {
-    found = numflds++ ;
-    strcpy( fld_name[found], vname ) ;
-    fld_bufsize[found] = *chunksize ;
+    if ( ( found = fld_add( vname ) ) == -1 ) return(1) ;
+    flds[found].bufsize = *chunksize ;
   }
   else
   {
-    fld_bufsize[found] += *chunksize ;
+    flds[found].bufsize += *chunksize ;
   }
-  if ( fld_cache[found] != NULL ) { free( fld_cache[found] ) ; }
-  fld_cache[found] = NULL ;
+  if ( flds[found].cache != NULL ) { free( flds[found].cache ) ; }
+  flds[found].cache = NULL ;
   return(0) ;
 }
 
@@ -184,8 +268,7 @@ STORE_PIECE_OF_FIELD_C ( char * buf , int varname[], int * chunksize, int *retva
   for ( i = 1; i <= n ; i++ ) { vname[i-1] = varname[i] ; }
   vname[n] = '\0' ;
 
-  found = -1 ;
-  for ( i = 0 ; i < numflds ; i++ ) { if ( !strcmp( fld_name[i], vname ) ) { found = i ; break ; } }
+  found = fld_lookup( vname ) ;
   if ( found == -1 ) { 
 #ifndef MS_SUA
     fprintf(stderr,"frame/pack_utils.c: field (%s) not found; was not set up with add_to_bufsize_for_field\n",vname ) ;
@@ -194,56 +277,93 @@ STORE_PIECE_OF_FIELD_C ( char * buf , int varname[], int * chunksize, int *retva
     return(0)  ;
   }
 
-  if ( fld_cache[found] == NULL ) {
-     fld_cache[found] = (char *) malloc( fld_bufsize[found] ) ;
-     fld_curs[found] = 0 ;
+  if ( flds[found].cache == NULL ) {
+     flds[found].cache = (char *) malloc( flds[found].bufsize ) ;
+     flds[found].curs = 0 ;
   }
 
-  if ( fld_curs[found] + *chunksize > fld_bufsize[found] ) {
+  if ( flds[found].curs + *chunksize > flds[found].bufsize ) {
 #ifndef MS_SUA
     fprintf(stderr,
-"frame/pack_utils.c: %s would overwrite %d + %d  > %d [%d]\n",vname, fld_curs[found], *chunksize, fld_bufsize[found], found ) ;
+"frame/pack_utils.c: %s would overwrite %d + %d  > %d [%d]\n",vname, flds[found].curs, *chunksize, flds[found].bufsize, found ) ;
 #endif
     *retval = 1 ;
     return(0)  ;
   }
 
-  bcopy( buf, fld_cache[found]+fld_curs[found], *chunksize ) ;
-  fld_curs[found] += *chunksize ;
+  bcopy( buf, flds[found].cache+flds[found].curs, *chunksize ) ;
+  flds[found].curs += *chunksize ;
   *retval = 0 ;
   return(0) ;
 }
 
+/* copy out the next field, at most insize bytes of it, and free its buffer */
+static int
+retrieve_next_field ( char * buf , int varname[], int insize )
+{
+  int i, outsize ;
+#ifndef MS_SUA
+  if ( flds[fld].curs > insize ) {
+    fprintf(stderr,"retrieve: fld_curs[%d] (%d) > *insize (%d)\n",fld,flds[fld].curs, insize ) ;
+  }
+#endif
+  outsize = ( flds[fld].curs <= insize ) ? flds[fld].curs : insize ;
+  if ( outsize > 0 ) bcopy( flds[fld].cache, buf, outsize ) ;
+  varname[0] = (int) strlen( flds[fld].name ) ;
+  for ( i = 1 ; i <= varname[0] ; i++ ) varname[i] = flds[fld].name[i-1] ;
+  if ( flds[fld].cache != NULL ) free ( flds[fld].cache ) ;
+  flds[fld].cache = NULL ;
+  flds[fld].bufsize = 0 ;
+  fld++ ;
+  return(outsize) ;
+}
+
 int
 RETRIEVE_PIECES_OF_FIELD_C ( char * buf , int varname[], int * insize, int * outsize, int *retval )
 {
-  int i, n ;
-  int found ;
-  char vname[256] ;
-
   if ( fld < numflds ) {
-#ifndef MS_SUA
-    if ( fld_curs[fld] > *insize ) {
-      fprintf(stderr,"retrieve: fld_curs[%d] (%d) > *insize (%d)\n",fld,fld_curs[fld], *insize ) ;
-    }
-#endif
-    *outsize = ( fld_curs[fld] <= *insize ) ? fld_curs[fld] : *insize ;
-    bcopy( fld_cache[fld], buf, *outsize ) ;
-    varname[0] = (int) strlen( fld_name[fld] ) ;
-    for ( i = 1 ; i <= varname[0] ; i++ ) varname[i] = fld_name[fld][i-1] ;
-    if ( fld_cache[fld] != NULL ) free ( fld_cache[fld] ) ;
-    fld_cache[fld] = NULL ;
-    fld_bufsize[fld] = 0 ;
-    fld++ ;
+    *outsize = retrieve_next_field( buf, varname, *insize ) ;
     *retval = 0 ;
   }
   else {
     numflds = 0 ;
+    fld_hash_clear() ;
     *retval = -1 ;
   }
   return(0) ;
 }
 
+/*
+   Bulk form of RETRIEVE_PIECES_OF_FIELD_C: hands back as many of the next
+   fields as fit whole in the insize bytes of buf, up to *maxout of them,
+   one after the other.  Field k takes outsize[k] bytes and its name comes
+   back in varnames[256*k], in the same form as above.  A single field that
+   is larger than buf is truncated, as it is by the one-field call.  *nout
+   is set to the number of fields returned and *retval to -1 once there
+   are none left.
+*/
+int
+RETRIEVE_PIECES_OF_FIELDS_C ( char * buf , int varnames[], int * insize, int * maxout,
+                              int * outsize, int * nout, int *retval )
+{
+  int used = 0 ;
+
+  *nout = 0 ;
+  if ( fld >= numflds ) {
+    numflds = 0 ;
+    fld_hash_clear() ;
+    *retval = -1 ;
+    return(0) ;
+  }
+  while ( fld < numflds && *nout < *maxout && ( *nout == 0 || used + flds[fld].curs <= *insize ) ) {
+    outsize[*nout] = retrieve_next_field( buf+used, varnames+256*(*nout), *insize-used ) ;
+    used += outsize[*nout] ;
+    (*nout)++ ;
+  }
+  *retval = 0 ;
+  return(0) ;
+}
+
 #define INDEX_2(A,B,NB)       ( (B) + (A)*(NB) )
 #define INDEX_3(A,B,C)  INDEX_2( (A), INDEX_2( (B), (C), (me[1]-ms[1]+1) ), (me[1]-ms[1]+1)*(me[0]-ms[0]+1) )
 /* flip low order bit of fp number */
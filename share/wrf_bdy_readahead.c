@@ -0,0 +1,243 @@
+#ifndef CRAY
+# ifdef NOUNDERSCORE
+#      define WRF_BDY_READAHEAD wrf_bdy_readahead
+# else
+#   ifdef F2CSTYLE
+#      define WRF_BDY_READAHEAD wrf_bdy_readahead__
+#   else
+#      define WRF_BDY_READAHEAD wrf_bdy_readahead_
+#   endif
+# endif
+#endif
+
+/*
+   wrf_bdy_readahead: ask the operating system to start reading the record
+   of a lateral boundary file whose Times entry equals a given date string,
+   so that the byte range is already in the page cache when input_boundary
+   gets around to it.  The call returns immediately; the kernel does the
+   reading in the background while the model integrates.
+
+   Only netCDF classic, 64-bit offset and CDF-5 files are understood
+   (io_form_boundary 2 and 11); in those formats every time level of the
+   record variables is stored as one contiguous block, whose position can
+   be worked out from the file header.  Anything else (HDF5-based netCDF-4,
+   GRIB, binary) is silently left alone: this is only a hint and never
+   changes what the model reads.
+
+   Return codes in *ierr: 0 readahead issued, 1 file not understood,
+   2 date not found in the file, 3 file could not be opened, 4 readahead
+   not supported (no posix_fadvise on this system, or the hint was
+   refused for this file).
+*/
+
+#if defined(FSEEKO_OK) || defined(FSEEKO64_OK)
+#  define _FILE_OFFSET_BITS 64
+#endif
+#ifndef _XOPEN_SOURCE
+#  define _XOPEN_SOURCE 600
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#define NC_DIMENSION  10
+#define NC_VARIABLE   11
+#define NC_ATTRIBUTE  12
+#define DATESTRLEN    19
+#define MAXHEADER     (16*1024*1024)
+
+typedef struct {
+  unsigned char * p ;
+  unsigned char * end ;
+  int version ;          /* 1 classic, 2 64-bit offset, 5 CDF-5 */
+  int bad ;
+} hdr_t ;
+
+static unsigned long long
+get_uint( hdr_t * h, int nbytes )
+{
+  unsigned long long v = 0 ;
+  int i ;
+  if ( h->bad || h->p + nbytes > h->end ) { h->bad = 1 ; return 0 ; }
+  for ( i = 0 ; i < nbytes ; i++ ) v = ( v << 8 ) | *(h->p)++ ;
+  return v ;
+}
+
+/* NON_NEG in the header grammar: 4 bytes, 8 for CDF-5 */
+static unsigned long long
+get_nonneg( hdr_t * h )
+{
+  return get_uint( h, h->version == 5 ? 8 : 4 ) ;
+}
+
+static void
+skip( hdr_t * h, unsigned long long n )
+{
+  n = ( n + 3 ) & ~3ULL ;                       /* padded to 4 bytes */
+  if ( h->bad || n > (unsigned long long)( h->end - h->p ) ) { h->bad = 1 ; return ; }
+  h->p += n ;
+}
+
+static int
+type_size( int nc_type )
+{
+  switch ( nc_type ) {
+    case 1 : case 2 : case 7 : return 1 ;
+    case 3 : case 8 :          return 2 ;
+    case 4 : case 5 : case 9 : return 4 ;
+    case 6 : case 10 : case 11 : return 8 ;
+  }
+  return 0 ;
+}
+
+static void
+skip_atts( hdr_t * h )
+{
+  unsigned long long tag, n, i, nc ;
+  int t ;
+  tag = get_uint( h, 4 ) ;
+  n = get_nonneg( h ) ;
+  if ( tag != NC_ATTRIBUTE ) { if ( n != 0 || tag != 0 ) h->bad = 1 ; return ; }
+  for ( i = 0 ; i < n && ! h->bad ; i++ ) {
+    skip( h, get_nonneg( h ) ) ;                /* name */
+    t = (int) get_uint( h, 4 ) ;
+    nc = get_nonneg( h ) ;
+    if ( type_size( t ) == 0 ) { h->bad = 1 ; return ; }
+    skip( h, nc * type_size( t ) ) ;
+  }
+}
+
+/*
+   Walk the header and return the offset of the first record, the size of
+   one record, the number of records, and the offset of the Times variable
+   within a record.  Returns 0 on success.
+*/
+static int
+parse_header( unsigned char * buf, size_t len,
+              unsigned long long * begin_rec, unsigned long long * recsize,
+              unsigned long long * numrecs, unsigned long long * times_off )
+{
+  hdr_t h ;
+  unsigned long long tag, ndims, nvars, i, j, nd, dimid, vsize, begin, nrecvars ;
+  unsigned long long recdim = ~0ULL ;
+  int t, is_times, found_times = 0 ;
+
+  if ( len < 8 || buf[0] != 'C' || buf[1] != 'D' || buf[2] != 'F' ) return 1 ;
+  h.p = buf + 4 ; h.end = buf + len ; h.version = buf[3] ; h.bad = 0 ;
+  if ( h.version != 1 && h.version != 2 && h.version != 5 ) return 1 ;
+
+  *numrecs = get_nonneg( &h ) ;
+
+  tag = get_uint( &h, 4 ) ;
+  ndims = get_nonneg( &h ) ;
+  if ( tag == NC_DIMENSION ) {
+    for ( i = 0 ; i < ndims && ! h.bad ; i++ ) {
+      skip( &h, get_nonneg( &h ) ) ;
+      if ( get_nonneg( &h ) == 0 ) recdim = i ;  /* the unlimited dimension */
+    }
+  }
+
+  skip_atts( &h ) ;                             /* global attributes */
+
+  *begin_rec = ~0ULL ; *recsize = 0 ; nrecvars = 0 ;
+  tag = get_uint( &h, 4 ) ;
+  nvars = get_nonneg( &h ) ;
+  if ( tag != NC_VARIABLE ) h.bad = 1 ;
+  for ( i = 0 ; i < nvars && ! h.bad ; i++ ) {
+    unsigned long long nlen = get_nonneg( &h ) ;
+    is_times = ( nlen == 5 && h.p + 5 <= h.end && ! strncmp( (char *) h.p, "Times", 5 ) ) ;
+    skip( &h, nlen ) ;
+    nd = get_nonneg( &h ) ;
+    dimid = ~0ULL ;
+    for ( j = 0 ; j < nd && ! h.bad ; j++ ) {
+      unsigned long long d = get_nonneg( &h ) ;
+      if ( j == 0 ) dimid = d ;
+    }
+    skip_atts( &h ) ;
+    t = (int) get_uint( &h, 4 ) ;
+    if ( type_size( t ) == 0 || ( is_times && t != 2 ) ) h.bad = 1 ;  /* Times is NC_CHAR */
+    vsize = get_nonneg( &h ) ;
+    begin = get_uint( &h, h.version == 1 ? 4 : 8 ) ;
+    if ( nd > 0 && dimid == recdim ) {
+      nrecvars++ ;
+      *recsize += vsize ;
+      if ( begin < *begin_rec ) *begin_rec = begin ;
+      if ( is_times ) { *times_off = begin ; found_times = 1 ; }
+    }
+  }
+  if ( h.bad || nrecvars == 0 || ! found_times ) return 1 ;
+  /* a lone record variable is stored without padding; vsize is close enough */
+  *times_off -= *begin_rec ;
+  return 0 ;
+}
+
+static int
+read_time( int fd, unsigned long long off, char * str )
+{
+  return pread( fd, str, DATESTRLEN, (off_t) off ) == DATESTRLEN ? 0 : 1 ;
+}
+
+void
+WRF_BDY_READAHEAD ( char * fname, int * fnamelen, char * datestr, int * ierr )
+{
+  char path[4096], want[DATESTRLEN+1], have[DATESTRLEN+1] ;
+  unsigned char * buf ;
+  ssize_t nread ;
+  unsigned long long begin_rec, recsize, numrecs, times_off, lo, hi, mid ;
+  int fd, n ;
+
+  *ierr = 3 ;
+  n = *fnamelen < (int) sizeof( path ) - 1 ? *fnamelen : (int) sizeof( path ) - 1 ;
+  strncpy( path, fname, n ) ; path[n] = '\0' ;
+  while ( n > 0 && path[n-1] == ' ' ) path[--n] = '\0' ;
+  strncpy( want, datestr, DATESTRLEN ) ; want[DATESTRLEN] = '\0' ;
+  have[DATESTRLEN] = '\0' ;
+
+  if ( ( fd = open( path, O_RDONLY ) ) < 0 ) return ;
+
+  *ierr = 1 ;
+  /* WRF boundary headers are a few tens of kilobytes; grow until it parses */
+  for ( n = 64*1024 ; n <= MAXHEADER ; n *= 4 ) {
+    if ( ( buf = (unsigned char *) malloc( n ) ) == NULL ) break ;
+    nread = pread( fd, buf, n, 0 ) ;
+    if ( nread > 0 &&
+         parse_header( buf, (size_t) nread, &begin_rec, &recsize, &numrecs, &times_off ) == 0 ) {
+      free( buf ) ;
+      *ierr = 0 ;
+      break ;
+    }
+    free( buf ) ;
+    if ( nread < n ) break ;
+  }
+  if ( *ierr != 0 ) { close( fd ) ; return ; }
+
+  /* numrecs may be the streaming marker; derive it from the file length */
+  if ( numrecs == 0xFFFFFFFFULL || numrecs == ~0ULL ) {
+    off_t fsize = lseek( fd, 0, SEEK_END ) ;
+    numrecs = fsize > (off_t) begin_rec ? ( fsize - begin_rec ) / recsize : 0 ;
+  }
+
+  /* Times increase monotonically through the file: bisect for the date */
+  *ierr = 2 ;
+  lo = 0 ; hi = numrecs ;
+  while ( lo < hi ) {
+    mid = lo + ( hi - lo ) / 2 ;
+    if ( read_time( fd, begin_rec + mid * recsize + times_off, have ) ) break ;
+    n = strncmp( have, want, DATESTRLEN ) ;
+    if ( n == 0 ) {
+#if defined(POSIX_FADV_WILLNEED)
+      *ierr = posix_fadvise( fd, (off_t)( begin_rec + mid * recsize ), (off_t) recsize,
+                             POSIX_FADV_WILLNEED ) == 0 ? 0 : 4 ;
+#else
+      *ierr = 4 ;
+#endif
+      break ;
+    }
+    if ( n < 0 ) lo = mid + 1 ; else hi = mid ;
+  }
+  close( fd ) ;
+}
@@ -76,6 +76,23 @@ get_count_for_alloc( node_t *node , int *numguys, int * stats )
 int
 nolistthese( char * ) ;
 
+/* true if the field is interpolated, forced or fed back between nest levels and so
+   has to be allocated on intermediate domains; a 4D array is if any member is */
+static int
+needed_on_intermediate ( node_t * p )
+{
+  node_t * q ;
+  int nest_paths = INTERP_DOWN | FORCE_DOWN | INTERP_UP | SMOOTH_UP ;
+
+  if ( p->node_kind & FOURD ) {
+    for ( q = p->members ; q != NULL ; q = q->next ) {
+      if ( q->nest_mask & nest_paths ) return(1) ;
+    }
+    return(0) ;
+  }
+  return( ( p->nest_mask & nest_paths ) != 0 ) ;
+}
+
 int
 gen_alloc2 ( FILE * fp , char * structname , char * structname2 , node_t * node, int *j, int *iguy, int *fraction, int numguys, int frac, int sw ) /* 1 = allocate, 2 = just count */
 {
@@ -229,8 +246,7 @@ if ( tag == 1 )
        if ( ! p->boundary_array ) { fprintf(fp,"IF(okay_to_alloc.AND.in_use_for_config(id,'%s')",fname2) ; }
        else                       { fprintf(fp,"IF(.TRUE.") ; }
 
-       if ( ! ( p->node_kind & FOURD ) && sw == 1 &&
-            ! ( p->nest_mask & INTERP_DOWN || p->nest_mask & FORCE_DOWN || p->nest_mask & INTERP_UP || p->nest_mask & SMOOTH_UP ) )
+       if ( sw == 1 && ! needed_on_intermediate( p ) )
        {
 	 fprintf(fp,".AND.(.NOT.grid%%is_intermediate)") ;
        }
@@ -573,6 +589,7 @@ int
 gen_dealloc ( char * dirname )
 {
   gen_dealloc1( dirname ) ; 
+  gen_rebind1( dirname ) ;
   return(0) ;
 }
 
@@ -679,6 +696,53 @@ structname, fname, structname, fname ) ;
   return(0) ;
 }
 
+/* 
+   Generate the pointer assignments that point grid%<field> back at the array
+   its state-list entry points to, selected by VarName.  Used by the offset
+   storage for moving nests (frame/module_domain.F), which rebuilds the
+   list entry's pointer as a window onto a flat store and then needs the
+   grid component to follow it.  Only fields that can be shifted that way
+   are listed; for anything else the CASE DEFAULT clears "known".
+*/
+int
+gen_rebind1 ( char * dirname )
+{
+  FILE * fp ;
+  node_t * p ;
+  char  fname[NAMELEN], vname[NAMELEN] ;
+  char * fn = "fieldlist_rebind.inc" ;
+  int tag, nd ;
+
+  if ( dirname == NULL ) return(1) ;
+  if ( strlen(dirname) > 0 ) { sprintf(fname,"%s/%s",dirname,fn) ; }
+  else                       { sprintf(fname,"%s",fn) ; }
+  if ((fp = fopen( fname , "w" )) == NULL ) return(1) ;
+  print_warning(fp,fname) ;
+#ifndef USE_ALLOCATABLES
+  for ( p = Domain.fields ; p != NULL ; p = p->next )
+  {
+    if ( ! ( p->node_kind & (FIELD | FOURD) ) || p->boundary_array || p->subgrid ) continue ;
+    if ( p->type == NULL || p->type->type_type != SIMPLE || nolistthese( p->name ) ) continue ;
+    if ( !strcmp( p->use , "_4d_bdy_array_" ) ) continue ;
+    if ( p->type->name[0] != 'r' && p->type->name[0] != 'd' && p->type->name[0] != 'i' ) continue ;
+    if ( p->proc_orient == ALL_X_ON_PROC || p->proc_orient == ALL_Y_ON_PROC ) continue ;
+    if ( ! get_dimnode_for_coord( p , COORD_X ) || ! get_dimnode_for_coord( p , COORD_Y ) ) continue ;
+    nd = p->ndims + ((p->node_kind & FOURD)?1:0) ;
+    if ( nd < 2 || nd > 4 ) continue ;
+    for ( tag = 1 ; tag <= p->ntl ; tag++ )
+    {
+      strcpy( vname, field_name( t4, p, (p->ntl>1)?tag:0 ) ) ;
+      fprintf(fp,"  CASE ( '%s' )\n", vname ) ;
+      fprintf(fp,"    IF ( rebind ) grid%%%s => p%%%cfield_%1dd\n", vname, p->type->name[0], nd ) ;
+    }
+  }
+#endif
+  fprintf(fp,"  CASE DEFAULT\n") ;
+  fprintf(fp,"    known = .FALSE.\n") ;
+  close_the_file( fp ) ;
+  return(0) ;
+}
+
 int
 nolistthese( char * name )
 {
@@ -286,6 +286,46 @@ if ( ! contains_tok ( halo_define , vname  , ":," ) ) {
 	  }
         }
 
+        if ( ( p->node_kind & FOURD ) && p->ndims <= 3 && down_path == INTERP_DOWN &&
+             !strcmp( fcn_name, "interp_fcn" ) && strlen( p->members->next->interpd_aux_fields ) == 0 )
+        {
+          /* all species of the 4d array in one call: they share staggering, dims and mask.
+             Interp-down only; force-down (bdy_interp) and feedback keep the per-species loop */
+fprintf(fp,"IF ( num_%s .GE. PARAM_FIRST_SCALAR ) THEN\n", p->name ) ;
+fprintf(fp,"IF ( SIZE( %s%s, %d ) * SIZE( %s%s, %d ) .GT. 1", p->name,tag,xdex+1,p->name,tag,ydex+1 ) ;
+          if(p->mp_var)
+            fprintf(fp," .and. (interp_mp .eqv. .true.)");
+fprintf(fp," ) THEN \n");
+fprintf(fp,"CALL interp_fcn_nspec (  &         \n" ) ;
+fprintf(fp,"                  %s%s(grid%%sm31,grid%%sm32,grid%%sm33,PARAM_FIRST_SCALAR),   &       ! CD field\n", p->name, tag ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! CD dims\n",
+                ddim[0][0], ddim[0][1], ddim[1][0], ddim[1][1], ddim[2][0], ddim[2][1] ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! CD dims\n",
+                mdim[0][0], mdim[0][1], mdim[1][0], mdim[1][1], mdim[2][0], mdim[2][1] ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! CD dims\n",
+                pdim[0][0], pdim[0][1], pdim2[1][0], pdim2[1][1], pdim[2][0], pdim[2][1] ) ;
+fprintf(fp,"                  ngrid%%%s%s(ngrid%%sm31,ngrid%%sm32,ngrid%%sm33,PARAM_FIRST_SCALAR),  &   ! ND field\n", p->name, tag2 ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! ND dims\n",
+                nddim[0][0], nddim[0][1], nddim[1][0], nddim[1][1], nddim[2][0], nddim[2][1] ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! ND dims\n",
+                nmdim[0][0], nmdim[0][1], nmdim[1][0], nmdim[1][1], nmdim[2][0], nmdim[2][1] ) ;
+fprintf(fp,"                 %s, %s, %s, %s, %s, %s,   &         ! ND dims\n",
+                npdim[0][0], npdim[0][1], npdim2[1][0], npdim2[1][1], npdim[2][0], npdim[2][1] ) ;
+  if ( sw_deref_kludge == 1 ) {
+fprintf(fp,"                  config_flags%%shw, ngrid%%imask%s(nims,njms),         &         ! stencil half width\n",maskstr) ;
+  } else {
+fprintf(fp,"                  config_flags%%shw, ngrid%%imask%s,         &         ! stencil half width\n",maskstr) ;
+  }
+fprintf(fp,"                  %s, %s,                                                &         ! xstag, ystag\n", xstag, ystag ) ;
+fprintf(fp,"                  ngrid%%i_parent_start, ngrid%%j_parent_start,                     &\n") ;
+fprintf(fp,"                  ngrid%%parent_grid_ratio, ngrid%%parent_grid_ratio,               &\n") ;
+fprintf(fp,"                  num_%s-PARAM_FIRST_SCALAR+1                                      &\n", p->name ) ;
+fprintf(fp,"                  ) \n") ;
+fprintf(fp,"ENDIF\n") ;
+fprintf(fp,"ENDIF\n") ;
+          continue ;
+        }
+
         if ( p->node_kind & FOURD )
 	{
             fprintf(fp,"DO itrace = PARAM_FIRST_SCALAR, num_%s\n",p->name ) ;
@@ -124,6 +124,7 @@ int gen_ddt_write1 ( FILE *, char *, node_t *);
 int gen_dealloc ( char * );
 int gen_dealloc1 ( char * );
 int gen_dealloc2 ( FILE *, char *, node_t *);
+int gen_rebind1 ( char * );
 int gen_scalar_tables ( FILE *);
 int AppendReg ( char *,int);
 int irr_diag_scalar_indices ( char * );
@@ -137,6 +138,8 @@ int gen_packs_halo ( FILE *fp , node_t *p, char *shw, int xy /* 0=y,1=x */ , int
 int gen_packs_halo ( FILE *fp , node_t *p, char *shw, int xy /* 0=y,1=x */ , int pu /* 0=pack,1=unpack */, char * packname, char * commname, int always_interp_mp /* 1 for ARW, varies for NMM */ );
 #endif
 int gen_packs ( FILE *fp , node_t *p, int shw, int xy /* 0=y,1=x */ , int pu /* 0=pack,1=unpack */, char * packname, char * commname );
+int gen_halo_guard ( FILE *fp , char *varref, int xdex, int ydex, char *varname );
+int gen_halo_sent ( FILE *fp , node_t *p, char *commname );
 int gen_periods ( char * dirname , node_t * periods );
 int gen_swaps ( char * dirname , node_t * swaps );
 int gen_cycles ( char * dirname , node_t * cycles );
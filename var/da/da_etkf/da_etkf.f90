@@ -9,9 +9,14 @@ module da_etkf
    use da_control, only : stdout, trace_use
    use da_gen_be, only : da_trace_entry, da_trace_exit
    use da_lapack, only : dsyev
+   use da_blas, only : dgemm
 
    implicit none
 
+   ! Rows of the left-hand matrix taken at a time by da_matmulti and
+   ! da_matmultiover
+   integer, parameter :: matmul_block = 256
+
 contains
 
 #include "da_innerprod.inc"
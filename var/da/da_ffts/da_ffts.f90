@@ -9,9 +9,8 @@ module da_ffts
       Inverse_FFT,  Forward_FFT, ids,jds, trace_use, &
       ide,jde, stdout
    use da_define_structures, only : xbx_type
-   use da_par_util, only : da_transpose_x2z, da_transpose_y2x, &
-      da_transpose_y2x_v2, da_transpose_z2x, da_transpose_x2y, &
-      da_transpose_x2y_v2
+   use da_par_util, only : da_transpose_x2z, da_transpose_z2x, &
+      da_transpose_x2y_pad, da_transpose_y2x_pad
    use da_tracing, only : da_trace_entry, da_trace_exit
    use da_wrf_interfaces, only : wrf_debug
    use module_dm, only : wrf_dm_sum_reals
@@ -26,6 +25,10 @@ module da_ffts
 
    implicit none
 
+   ! FFT work array of the Poisson solvers, grown on demand and kept between
+   ! calls rather than allocated on every solve.
+   real, allocatable, private :: work_1d(:)
+
    contains
 
 #include "da_solve_poissoneqn_fct.inc"
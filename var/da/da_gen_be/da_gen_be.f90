@@ -24,6 +24,9 @@ module da_gen_be
    implicit none
 
    real, parameter :: base_pres = 100000.0 ! Hardwired - link to namelist later.
+
+   character(len=200) :: get_field_file = ''  ! File held open by da_get_field.
+   integer            :: get_field_cdfid      ! Its NETCDF id.
                
 contains
 
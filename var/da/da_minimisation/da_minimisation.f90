@@ -5,7 +5,7 @@ module da_minimisation
    !---------------------------------------------------------------------------
 
    use module_configure, only : grid_config_rec_type
-   use module_dm, only : wrf_dm_sum_real, wrf_dm_sum_integer
+   use module_dm, only : wrf_dm_sum_real, wrf_dm_sum_reals, wrf_dm_sum_integer
 #ifdef DM_PARALLEL
    use module_dm, only : local_communicator, mytask, ntasks, ntasks_x, &
       ntasks_y, data_order_xy, data_order_xyz
@@ -50,7 +50,7 @@ module da_minimisation
       num_procs, myproc, use_gpspwobs, use_rainobs, use_gpsztdobs, &
       use_radar_rf, use_radar_rhv,use_radar_rqv,pseudo_var, num_pseudo, &
       num_ob_indexes, num_ob_vars, npres_print, pptop, ppbot, qcstat_conv_unit, gas_constant, &
-      orthonorm_gradient, its, ite, jts, jte, kts, kte, ids, ide, jds, jde, kds, kde, cp, &
+      orthonorm_gradient, cg_fused_dots, its, ite, jts, jte, kts, kte, ids, ide, jds, jde, kds, kde, cp, &
       use_satcv, sensitivity_option, print_detail_outerloop, adj_sens, filename_len, &
       ims, ime, jms, jme, kms, kme, ips, ipe, jps, jpe, kps, kpe, fgat_rain_flags, var4d_bin_rain, freeze_varbc, &
       use_wpec, wpec_factor, use_4denvar, anal_type_hybrid_dual_res, alphacv_method, alphacv_method_xa, &
@@ -179,7 +179,7 @@ module da_minimisation
     include 'mpif.h'
 #endif
 
-   private :: da_dot, da_dot_cv
+   private :: da_dot, da_dot_cv, da_dot_cv_local
 
 contains
       
@@ -191,6 +191,7 @@ contains
 #include "da_get_innov_vector.inc"
 #include "da_dot.inc"
 #include "da_dot_cv.inc"
+#include "da_dot_cv_local.inc"
 #include "da_write_diagnostics.inc"
 #include "da_minimise_cg.inc"
 #include "da_minimise_lz.inc"
@@ -69,6 +69,15 @@ module da_obs_io
    include 'mpif.h'
 #endif
 
+   ! Index of the gts_omb file being read by da_read_iv_for_multi_inc, built
+   ! by da_search_obs_load: file position, station id and location of every
+   ! observation, chained into hash buckets on id and rounded lat/lon.
+   integer, parameter :: omb_quant = 1000        ! lat/lon rounded to 1/omb_quant degree for hashing
+   integer              :: omb_unit, omb_nobs, omb_nhash
+   integer, allocatable :: omb_pos(:), omb_next(:), omb_head(:)
+   character(len=5), allocatable :: omb_id(:)
+   real, allocatable    :: omb_lat(:), omb_lon(:)
+
 contains
 
 #include "da_read_obs_ascii.inc"
@@ -83,6 +92,8 @@ contains
 #include "da_write_iv_for_multi_inc.inc"
 #include "da_read_iv_for_multi_inc.inc"
 #include "da_search_obs.inc"
+#include "da_search_obs_load.inc"
+#include "da_search_obs_hash.inc"
 #include "da_write_obs_etkf.inc"
 #include "da_write_filtered_obs.inc"
 #include "da_write_modified_filtered_obs.inc"
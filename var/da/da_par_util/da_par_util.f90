@@ -50,6 +50,15 @@ module da_par_util
 
 #include "da_generic_typedefs.inc"
 
+#ifdef DM_PARALLEL
+   ! Exchange plan of da_transpose_x2y_pad/da_transpose_y2x_pad, built by
+   ! da_transpose_pad_plan and reused while the grid and pad layout are fixed.
+   integer              :: xpad_id = -1, xpad_n = -1, xpad_inc = -1
+   integer, allocatable :: xpad_bnds(:,:)
+   integer, allocatable :: xpad_xcnt(:), xpad_xdsp(:), xpad_ycnt(:), xpad_ydsp(:)
+   real,    allocatable :: xpad_xbuf(:), xpad_ybuf(:)
+#endif
+
    interface da_patch_to_global
       module procedure da_patch_to_global_2d
       module procedure da_patch_to_global_3d
@@ -72,6 +81,9 @@ module da_par_util
 #include "da_transpose_z2y.inc"
 #include "da_transpose_x2y_v2.inc"
 #include "da_transpose_y2x_v2.inc"
+#include "da_transpose_pad_plan.inc"
+#include "da_transpose_x2y_pad.inc"
+#include "da_transpose_y2x_pad.inc"
 
 #include "da_cv_to_global.inc"
 #include "da_patch_to_global_2d.inc"